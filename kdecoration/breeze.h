@@ -19,6 +19,9 @@ namespace Breeze
     using InternalSettingsList = QList<InternalSettingsPtr>;
     using InternalSettingsListIterator = QListIterator<InternalSettingsPtr>;
 
+    class SettingsSnapshot;
+    using SettingsSnapshotPtr = QSharedPointer<const SettingsSnapshot>;
+
     //* metrics
     enum Metrics
     {
@@ -52,7 +55,10 @@ namespace Breeze
     enum ExceptionMask
     {
         None = 0,
-        BorderSize = 1<<4
+        BorderSize = 1<<4,
+        ShadowSize = 1<<5,
+        ShadowStrength = 1<<6,
+        AnimationsDuration = 1<<7
     };
 }
 
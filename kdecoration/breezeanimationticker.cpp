@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Breeze Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only OR LicenseRef-KDE-Accepted-GPL
+ */
+
+#include "breezeanimationticker.h"
+
+#include <QCoreApplication>
+
+namespace Breeze
+{
+
+    //__________________________________________________________________
+    Animation::~Animation()
+    { if( m_running ) AnimationTicker::self()->unregisterAnimation( this ); }
+
+    //__________________________________________________________________
+    void Animation::start()
+    {
+
+        const bool forward( m_direction == QAbstractAnimation::Forward );
+        if( m_duration <= 0 )
+        {
+
+            // no animation, jump to end value
+            stop();
+            m_progress = forward ? 1 : 0;
+
+        } else {
+
+            m_progress = forward ? 0 : 1;
+            if( !m_running )
+            {
+                m_running = true;
+                AnimationTicker::self()->registerAnimation( this );
+            }
+
+        }
+
+        emit valueChanged( value() );
+
+    }
+
+    //__________________________________________________________________
+    void Animation::stop()
+    {
+        if( !m_running ) return;
+        m_running = false;
+        AnimationTicker::self()->unregisterAnimation( this );
+    }
+
+    //__________________________________________________________________
+    bool Animation::advance( qint64 elapsed )
+    {
+
+        const qreal delta( m_duration > 0 ? qreal( elapsed )/m_duration : 1 );
+        const bool forward( m_direction == QAbstractAnimation::Forward );
+        m_progress = qBound<qreal>( 0, forward ? m_progress + delta : m_progress - delta, 1 );
+
+        // check end of animation
+        if( m_progress == ( forward ? 1 : 0 ) ) m_running = false;
+
+        emit valueChanged( value() );
+        return m_running;
+
+    }
+
+    //__________________________________________________________________
+    AnimationTicker *AnimationTicker::s_self = nullptr;
+
+    //__________________________________________________________________
+    AnimationTicker::AnimationTicker( QObject *parent ):
+        QObject( parent )
+    {
+        // one tick per frame, for a 60Hz display
+        m_timer.setInterval( 16 );
+        m_timer.setTimerType( Qt::PreciseTimer );
+        connect( &m_timer, &QTimer::timeout, this, &AnimationTicker::tick );
+    }
+
+    //__________________________________________________________________
+    AnimationTicker::~AnimationTicker()
+    {
+        // animations still running are stopped, so that they do not unregister later on
+        for( auto animation : qAsConst( m_animations ) )
+        { animation->m_running = false; }
+
+        s_self = nullptr;
+    }
+
+    //__________________________________________________________________
+    AnimationTicker *AnimationTicker::self()
+    {
+        if( !s_self )
+        { s_self = new AnimationTicker( QCoreApplication::instance() ); }
+
+        return s_self;
+    }
+
+    //__________________________________________________________________
+    void AnimationTicker::registerAnimation( Animation *animation )
+    {
+        if( m_animations.contains( animation ) ) return;
+        m_animations.append( animation );
+
+        if( !m_timer.isActive() )
+        {
+            m_clock.start();
+            m_timer.start();
+        }
+    }
+
+    //__________________________________________________________________
+    void AnimationTicker::unregisterAnimation( Animation *animation )
+    {
+        m_animations.removeOne( animation );
+        if( m_animations.isEmpty() ) m_timer.stop();
+    }
+
+    //__________________________________________________________________
+    void AnimationTicker::scheduleUpdate( KDecoration2::Decoration *decoration, const QRect &rect )
+    {
+
+        if( !m_ticking )
+        {
+            if( rect.isEmpty() ) decoration->update();
+            else decoration->update( rect );
+            return;
+        }
+
+        // merge with pending repaint. Empty rect stands for the full decoration
+        auto iter = m_pendingUpdates.find( decoration );
+        if( iter == m_pendingUpdates.end() ) m_pendingUpdates.insert( decoration, rect );
+        else if( rect.isEmpty() ) *iter = QRect();
+        else if( !iter->isEmpty() ) *iter |= rect;
+
+    }
+
+    //__________________________________________________________________
+    void AnimationTicker::tick()
+    {
+
+        const qint64 elapsed = m_clock.restart();
+
+        // advance all animations. Callbacks may start or stop other animations
+        m_ticking = true;
+        const auto animations( m_animations );
+        for( auto animation : animations )
+        {
+            if( !m_animations.contains( animation ) ) continue;
+            if( !animation->advance( elapsed ) ) m_animations.removeOne( animation );
+        }
+        m_ticking = false;
+
+        // one repaint per decoration
+        for( auto iter = m_pendingUpdates.constBegin(); iter != m_pendingUpdates.constEnd(); ++iter )
+        {
+            if( iter.value().isEmpty() ) iter.key()->update();
+            else iter.key()->update( iter.value() );
+        }
+
+        m_pendingUpdates.clear();
+
+        if( m_animations.isEmpty() ) m_timer.stop();
+
+    }
+
+}
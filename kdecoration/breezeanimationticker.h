@@ -0,0 +1,174 @@
+#ifndef breezeanimationticker_h
+#define breezeanimationticker_h
+
+/*
+ * SPDX-FileCopyrightText: 2021 Breeze Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only OR LicenseRef-KDE-Accepted-GPL
+ */
+
+#include <KDecoration2/Decoration>
+
+#include <QAbstractAnimation>
+#include <QEasingCurve>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QRect>
+#include <QTimer>
+
+namespace Breeze
+{
+
+    class AnimationTicker;
+
+    //* animation from 0 to 1, driven by the shared animation ticker
+    /**
+    provides the subset of QVariantAnimation used by decorations and buttons,
+    without owning a timer
+    */
+    class Animation: public QObject
+    {
+
+        Q_OBJECT
+
+        public:
+
+        //* constructor
+        explicit Animation( QObject* parent ):
+            QObject( parent )
+        {}
+
+        //* destructor
+        ~Animation() override;
+
+        //*@name accessors
+        //@{
+
+        int duration() const
+        { return m_duration; }
+
+        QAbstractAnimation::Direction direction() const
+        { return m_direction; }
+
+        QAbstractAnimation::State state() const
+        { return m_running ? QAbstractAnimation::Running : QAbstractAnimation::Stopped; }
+
+        //* current, eased, value
+        qreal value() const
+        { return m_easingCurve.valueForProgress( m_progress ); }
+
+        //@}
+
+        //*@name modifiers
+        //@{
+
+        void setDuration( int value )
+        { m_duration = value; }
+
+        void setEasingCurve( const QEasingCurve& value )
+        { m_easingCurve = value; }
+
+        //* direction. Changing it while running reverts the animation from its current value
+        void setDirection( QAbstractAnimation::Direction value )
+        { m_direction = value; }
+
+        //* start, from the beginning of current direction
+        void start();
+
+        //* stop at current value
+        void stop();
+
+        //@}
+
+        Q_SIGNALS:
+
+        //* emitted each time the animation is advanced
+        void valueChanged( qreal );
+
+        private:
+
+        //* advance by given time (ms). Returns false when finished
+        bool advance( qint64 );
+
+        //* duration (ms)
+        int m_duration = 250;
+
+        //* easing curve
+        QEasingCurve m_easingCurve;
+
+        //* direction
+        QAbstractAnimation::Direction m_direction = QAbstractAnimation::Forward;
+
+        //* linear progress, between 0 and 1
+        qreal m_progress = 0;
+
+        //* running state
+        bool m_running = false;
+
+        friend class AnimationTicker;
+
+    };
+
+    //* process wide timer advancing all running animations in one pass
+    /**
+    repaints requested while animations are advanced are merged,
+    and issued once per decoration at the end of the pass
+    */
+    class AnimationTicker: public QObject
+    {
+
+        Q_OBJECT
+
+        public:
+
+        //* singleton. It is owned by the application
+        static AnimationTicker *self();
+
+        //* destructor
+        ~AnimationTicker();
+
+        //* register running animation
+        void registerAnimation( Animation* );
+
+        //* unregister animation
+        void unregisterAnimation( Animation* );
+
+        //* request repaint of a decoration region. Empty rect means the full decoration
+        /** when called while animations are advanced, the repaint is delayed to the end of the pass */
+        void scheduleUpdate( KDecoration2::Decoration*, const QRect& = QRect() );
+
+        private Q_SLOTS:
+
+        //* advance all animations
+        void tick();
+
+        private:
+
+        //* constructor
+        explicit AnimationTicker( QObject* );
+
+        //* timer
+        QTimer m_timer;
+
+        //* time of last tick
+        QElapsedTimer m_clock;
+
+        //* running animations
+        QList<Animation*> m_animations;
+
+        //* pending repaints, per decoration
+        QHash<KDecoration2::Decoration*, QRect> m_pendingUpdates;
+
+        //* true while animations are advanced
+        bool m_ticking = false;
+
+        //* singleton
+        static AnimationTicker *s_self;
+
+    };
+
+}
+
+#endif
@@ -5,13 +5,14 @@
  * SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only OR LicenseRef-KDE-Accepted-GPL
  */
 #include "breezebutton.h"
+#include "breezesettingsprovider.h"
 
 #include <KDecoration2/DecoratedClient>
 #include <KColorUtils>
 #include <KIconLoader>
 
 #include <QPainter>
-#include <QVariantAnimation>
+#include <QPixmap>
 #include <QPainterPath>
 
 namespace Breeze
@@ -25,16 +26,16 @@ namespace Breeze
     //__________________________________________________________________
     Button::Button(DecorationButtonType type, Decoration* decoration, QObject* parent)
         : DecorationButton(type, decoration, parent)
-        , m_animation( new QVariantAnimation( this ) )
+        , m_animation( new Animation( this ) )
     {
 
         // setup animation
-        // It is important start and end value are of the same type, hence 0.0 and not just 0
-        m_animation->setStartValue( 0.0 );
-        m_animation->setEndValue( 1.0 );
+        // repaints are merged with other animations by the shared ticker
         m_animation->setEasingCurve( QEasingCurve::InOutQuad );
-        connect(m_animation, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-            setOpacity(value.toReal());
+        connect(m_animation, &Animation::valueChanged, this, [this](qreal value) {
+            if( m_opacity == value ) return;
+            m_opacity = value;
+            AnimationTicker::self()->scheduleUpdate( decoration(), geometry().toAlignedRect() );
         });
 
         // setup default geometry
@@ -44,7 +45,7 @@ namespace Breeze
 
         // connections
         connect(decoration->client().data(), SIGNAL(iconChanged(QIcon)), this, SLOT(update()));
-        connect(decoration->settings().data(), &KDecoration2::DecorationSettings::reconfigured, this, &Button::reconfigure);
+        connect(SettingsProvider::self(), &SettingsProvider::reconfigured, this, &Button::reconfigure);
         connect( this, &KDecoration2::DecorationButton::hoveredChanged, this, &Button::updateAnimationState );
 
         reconfigure();
@@ -96,7 +97,8 @@ namespace Breeze
                 break;
 
                 case DecorationButtonType::Menu:
-                QObject::connect(d->client().data(), &KDecoration2::DecoratedClient::iconChanged, b, [b]() { b->update(); });
+                QObject::connect(d->client().data(), &KDecoration2::DecoratedClient::iconChanged, b, [b]() { b->resetIconCache(); b->update(); });
+                QObject::connect(d->client().data(), &KDecoration2::DecoratedClient::paletteChanged, b, [b]() { b->resetIconCache(); b->update(); });
                 break;
 
                 default: break;
@@ -129,21 +131,8 @@ namespace Breeze
         if (type() == DecorationButtonType::Menu)
         {
 
-            const QRectF iconRect( geometry().topLeft(), m_iconSize );
-            if (auto deco =  qobject_cast<Decoration*>(decoration())) {
-                const QPalette activePalette = KIconLoader::global()->customPalette();
-                QPalette palette = decoration()->client().data()->palette();
-                palette.setColor(QPalette::Foreground, deco->fontColor());
-                KIconLoader::global()->setCustomPalette(palette);
-                decoration()->client().data()->icon().paint(painter, iconRect.toRect());
-                if (activePalette == QPalette()) {
-                    KIconLoader::global()->resetPalette();
-                }    else {
-                    KIconLoader::global()->setCustomPalette(palette);
-                }
-            } else {
-                decoration()->client().data()->icon().paint(painter, iconRect.toRect());
-            }
+            // client icon is rendered once, and cached
+            painter->drawPixmap( geometry().topLeft(), iconPixmap( painter->device()->devicePixelRatioF() ) );
 
         } else {
 
@@ -155,6 +144,59 @@ namespace Breeze
 
     }
 
+    //__________________________________________________________________
+    const QPixmap& Button::iconPixmap( qreal devicePixelRatio )
+    {
+
+        auto client = decoration()->client().data();
+        const QIcon icon( client->icon() );
+        auto deco = qobject_cast<Decoration*>(decoration());
+        const QColor fontColor( deco ? deco->fontColor() : QColor() );
+
+        // check cache
+        if( !m_iconPixmap.isNull() &&
+            m_iconCacheKey == icon.cacheKey() &&
+            m_iconPixmapSize == m_iconSize &&
+            m_iconDevicePixelRatio == devicePixelRatio &&
+            m_iconFontColor == fontColor )
+        { return m_iconPixmap; }
+
+        m_iconCacheKey = icon.cacheKey();
+        m_iconPixmapSize = m_iconSize;
+        m_iconDevicePixelRatio = devicePixelRatio;
+        m_iconFontColor = fontColor;
+
+        m_iconPixmap = QPixmap( m_iconSize*devicePixelRatio );
+        m_iconPixmap.setDevicePixelRatio( devicePixelRatio );
+        m_iconPixmap.fill( Qt::transparent );
+
+        QPainter painter( &m_iconPixmap );
+        const QRect iconRect( QPoint( 0, 0 ), m_iconSize );
+        if( deco )
+        {
+
+            // render symbolic icons with the caption color
+            const QPalette activePalette = KIconLoader::global()->customPalette();
+            QPalette palette = client->palette();
+            palette.setColor(QPalette::Foreground, fontColor);
+            KIconLoader::global()->setCustomPalette(palette);
+            icon.paint(&painter, iconRect);
+            if (activePalette == QPalette()) {
+                KIconLoader::global()->resetPalette();
+            }    else {
+                KIconLoader::global()->setCustomPalette(activePalette);
+            }
+
+        } else {
+
+            icon.paint(&painter, iconRect);
+
+        }
+
+        return m_iconPixmap;
+
+    }
+
     //__________________________________________________________________
     void Button::drawIcon( QPainter *painter ) const
     {
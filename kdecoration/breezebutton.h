@@ -8,12 +8,12 @@
 * SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only OR LicenseRef-KDE-Accepted-GPL
 */
 #include <KDecoration2/DecorationButton>
+#include "breezeanimationticker.h"
 #include "breezedecoration.h"
 
 #include <QHash>
 #include <QImage>
-
-class QVariantAnimation;
+#include <QPixmap>
 
 namespace Breeze
 {
@@ -98,6 +98,14 @@ namespace Breeze
         //* draw button icon
         void drawIcon( QPainter *) const;
 
+        //* client icon pixmap, for menu button
+        /** the pixmap is cached, and only rendered again when icon, size, device pixel ratio or font color change */
+        const QPixmap& iconPixmap( qreal devicePixelRatio );
+
+        //* reset cached client icon pixmap
+        void resetIconCache()
+        { m_iconPixmap = QPixmap(); }
+
         //*@name colors
         //@{
         QColor foregroundColor() const;
@@ -107,7 +115,7 @@ namespace Breeze
         Flag m_flag = FlagNone;
 
         //* active state change animation
-        QVariantAnimation *m_animation;
+        Animation *m_animation;
 
         //* vertical offset (for rendering)
         QPointF m_offset;
@@ -117,6 +125,16 @@ namespace Breeze
 
         //* active state change opacity
         qreal m_opacity = 0;
+
+        //*@name cached client icon pixmap
+        //@{
+        QPixmap m_iconPixmap;
+        qint64 m_iconCacheKey = 0;
+        QSize m_iconPixmapSize;
+        qreal m_iconDevicePixelRatio = 1;
+        QColor m_iconFontColor;
+        //@}
+
     };
 
 } // namespace
@@ -20,15 +20,16 @@
 #include <KDecoration2/DecorationButtonGroup>
 #include <KDecoration2/DecorationShadow>
 
-#include <KConfigGroup>
 #include <KColorUtils>
-#include <KSharedConfig>
 #include <KPluginFactory>
 
+#include <QFutureWatcher>
+#include <QHash>
 #include <QPainter>
+#include <QStaticText>
 #include <QTextStream>
 #include <QTimer>
-#include <QDBusConnection>
+#include <QtConcurrentRun>
 
 #if BREEZE_HAVE_X11
 #include <QX11Info>
@@ -42,6 +43,7 @@ K_PLUGIN_FACTORY_WITH_JSON(
     registerPlugin<Breeze::Decoration>();
     registerPlugin<Breeze::Button>(QStringLiteral("button"));
     registerPlugin<Breeze::ConfigWidget>(QStringLiteral("kcmodule"));
+    Breeze::Decoration::prewarmShadows();
 )
 
 namespace
@@ -125,6 +127,34 @@ namespace
             return s_shadowParams[3];
         }
     }
+
+    //* true if settings affecting the borders differ
+    inline bool bordersChanged(const Breeze::InternalSettings &first, const Breeze::InternalSettings &second)
+    {
+        return (first.mask() & Breeze::BorderSize) != (second.mask() & Breeze::BorderSize)
+            || first.borderSize() != second.borderSize()
+            || first.hideTitleBar() != second.hideTitleBar()
+            || first.buttonSize() != second.buttonSize()
+            || first.drawBorderOnMaximizedWindows() != second.drawBorderOnMaximizedWindows();
+    }
+
+    //* true if settings affecting the shadow differ
+    inline bool shadowChanged(const Breeze::InternalSettings &first, const Breeze::InternalSettings &second)
+    {
+        return first.shadowSize() != second.shadowSize()
+            || first.shadowStrength() != second.shadowStrength()
+            || first.shadowColor() != second.shadowColor()
+            || first.drawShadowOnMaximizedWindows() != second.drawShadowOnMaximizedWindows();
+    }
+
+    //* true if settings affecting painting only differ
+    inline bool appearanceChanged(const Breeze::InternalSettings &first, const Breeze::InternalSettings &second)
+    {
+        return first.titleAlignment() != second.titleAlignment()
+            || first.drawTitleBarSeparator() != second.drawTitleBarSeparator()
+            || first.drawBackgroundGradient() != second.drawBackgroundGradient()
+            || first.outlineCloseButton() != second.outlineCloseButton();
+    }
 }
 
 namespace Breeze
@@ -135,17 +165,228 @@ namespace Breeze
 
     //________________________________________________________________
     static int g_sDecoCount = 0;
-    static int g_shadowSizeEnum = InternalSettings::ShadowLarge;
-    static int g_shadowStrength = 255;
-    static QColor g_shadowColor = Qt::black;
-    static QSharedPointer<KDecoration2::DecorationShadow> g_sShadow;
-    static QSharedPointer<KDecoration2::DecorationShadow> g_sShadowInactive;
+
+    //* shadows, shared by all decorations with the same shadow settings and active state
+    static QHash<quint64, QSharedPointer<KDecoration2::DecorationShadow>> g_shadowCache;
+
+    //* settings snapshot version for which shadows were cached
+    static int g_shadowCacheVersion = -1;
+
+    //* shadow settings, copied from internal settings so that shadows can be rendered in a worker thread
+    class ShadowSpec
+    {
+        public:
+
+        QColor color;
+        int strength = 0;
+        int size = 0;
+        qreal strengthScale = 1.0;
+    };
+
+    //* rendered shadow texture, and its geometry
+    class ShadowTexture
+    {
+        public:
+
+        QImage image;
+        QMargins padding;
+        QRect innerShadowRect;
+    };
+
+    //* shadow being rendered in a worker thread
+    class PendingShadow
+    {
+        public:
+
+        //* settings snapshot version
+        int version = -1;
+
+        //* texture
+        QFuture<ShadowTexture> texture;
+    };
+
+    //* shadows being rendered in worker threads, per cache key
+    static QHash<quint64, PendingShadow> g_pendingShadows;
+
+    //________________________________________________________________
+    static ShadowSpec shadowSpec(const InternalSettings &internalSettings, qreal strengthScale)
+    {
+        ShadowSpec spec;
+        spec.color = internalSettings.shadowColor();
+        spec.strength = internalSettings.shadowStrength();
+        spec.size = internalSettings.shadowSize();
+        spec.strengthScale = strengthScale;
+        return spec;
+    }
+
+    //________________________________________________________________
+    static quint64 shadowCacheKey(const InternalSettings &internalSettings, bool active)
+    {
+        return (quint64(internalSettings.shadowColor().rgba()) << 32)
+            | (quint64(internalSettings.shadowStrength() & 0xff) << 8)
+            | (quint64(internalSettings.shadowSize() & 0x7f) << 1)
+            | (active ? 1 : 0);
+    }
+
+    //________________________________________________________________
+    static void clearShadowCache(int version)
+    {
+        g_shadowCache.clear();
+        g_pendingShadows.clear();
+        g_shadowCacheVersion = version;
+    }
+
+    //________________________________________________________________
+    // only uses QImage and QPainter, and is safe to call from any thread
+    static ShadowTexture renderShadowTexture(const ShadowSpec &spec)
+    {
+          const CompositeShadowParams params = lookupShadowParams(spec.size);
+          if (params.isNone())
+          {
+              return ShadowTexture();
+          }
+
+          auto withOpacity = [](const QColor& color, qreal opacity) -> QColor {
+              QColor c(color);
+              c.setAlphaF(opacity);
+              return c;
+          };
+
+
+          const QSize boxSize = BoxShadowRenderer::calculateMinimumBoxSize(params.shadow1.radius)
+              .expandedTo(BoxShadowRenderer::calculateMinimumBoxSize(params.shadow2.radius));
+
+          BoxShadowRenderer shadowRenderer;
+          shadowRenderer.setBorderRadius(Metrics::Frame_FrameRadius + 0.5);
+          shadowRenderer.setBoxSize(boxSize);
+          shadowRenderer.setDevicePixelRatio(1.0); // TODO: Create HiDPI shadows?
+          shadowRenderer.setDownsamplingEnabled(true);
+
+          const qreal strength = spec.strength / 255.0 * spec.strengthScale;
+          shadowRenderer.addShadow(params.shadow1.offset, params.shadow1.radius,
+              withOpacity(spec.color, params.shadow1.opacity * strength));
+          shadowRenderer.addShadow(params.shadow2.offset, params.shadow2.radius,
+              withOpacity(spec.color, params.shadow2.opacity * strength));
+
+          // textures are rendered both from the GUI thread and from prewarming threads.
+          // Each thread reuses its own working memory
+          static thread_local BoxShadowRenderer::ScratchArena arena;
+          QImage shadowTexture = shadowRenderer.render(&arena);
+
+          QPainter painter(&shadowTexture);
+          painter.setRenderHint(QPainter::Antialiasing);
+
+          const QRect outerRect = shadowTexture.rect();
+
+          QRect boxRect(QPoint(0, 0), boxSize);
+          boxRect.moveCenter(outerRect.center());
+
+          // Mask out inner rect.
+          const QMargins padding = QMargins(
+              boxRect.left() - outerRect.left() - Metrics::Shadow_Overlap - params.offset.x(),
+              boxRect.top() - outerRect.top() - Metrics::Shadow_Overlap - params.offset.y(),
+              outerRect.right() - boxRect.right() - Metrics::Shadow_Overlap + params.offset.x(),
+              outerRect.bottom() - boxRect.bottom() - Metrics::Shadow_Overlap + params.offset.y());
+          const QRect innerRect = outerRect - padding;
+
+          painter.setPen(Qt::NoPen);
+          painter.setBrush(Qt::black);
+          painter.setCompositionMode(QPainter::CompositionMode_DestinationOut);
+          painter.drawRoundedRect(
+              innerRect,
+              Metrics::Frame_FrameRadius + 0.5,
+              Metrics::Frame_FrameRadius + 0.5);
+
+          // Draw outline.
+          painter.setPen(withOpacity(spec.color, 0.2 * strength));
+          painter.setBrush(Qt::NoBrush);
+          painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+          painter.drawRoundedRect(
+              innerRect,
+              Metrics::Frame_FrameRadius - 0.5,
+              Metrics::Frame_FrameRadius - 0.5);
+
+          painter.end();
+
+          ShadowTexture texture;
+          texture.image = shadowTexture;
+          texture.padding = padding;
+          texture.innerShadowRect = QRect(outerRect.center(), QSize(1, 1));
+          return texture;
+    }
+
+    //________________________________________________________________
+    static QSharedPointer<KDecoration2::DecorationShadow> toShadowObject(const ShadowTexture &texture)
+    {
+        if( texture.image.isNull() ) return nullptr;
+
+        auto ret = QSharedPointer<KDecoration2::DecorationShadow>::create();
+        ret->setPadding(texture.padding);
+        ret->setInnerShadowRect(texture.innerShadowRect);
+        ret->setShadow(texture.image);
+        return ret;
+    }
+
+    //________________________________________________________________
+    static void publishPrewarmedShadow(quint64 key, int version)
+    {
+        auto pending = g_pendingShadows.find(key);
+        if( pending == g_pendingShadows.end() || pending->version != version ) return;
+
+        const ShadowTexture texture = pending->texture.result();
+        g_pendingShadows.erase(pending);
+
+        // the shadow might have been created synchronously in the meantime
+        if( version != g_shadowCacheVersion || g_shadowCache.contains(key) ) return;
+        g_shadowCache.insert(key, toShadowObject(texture));
+    }
+
+    //________________________________________________________________
+    void Decoration::prewarmShadows()
+    {
+        auto provider = SettingsProvider::self();
+
+        // shadows are rendered again each time the configuration changes
+        static bool connected = false;
+        if( !connected )
+        {
+            QObject::connect(provider, &SettingsProvider::reconfigured, provider, &Decoration::prewarmShadows);
+            connected = true;
+        }
+
+        const auto snapshot = provider->snapshot();
+        if( g_shadowCacheVersion != snapshot->version ) clearShadowCache(snapshot->version);
+
+        // render active and inactive shadows for default settings
+        const InternalSettings &internalSettings = *snapshot->defaultSettings;
+        if( lookupShadowParams(internalSettings.shadowSize()).isNone() ) return;
+
+        for( const bool active : { true, false } )
+        {
+            const quint64 key = shadowCacheKey(internalSettings, active);
+            if( g_shadowCache.contains(key) || g_pendingShadows.contains(key) ) continue;
+
+            PendingShadow pending;
+            pending.version = snapshot->version;
+            pending.texture = QtConcurrent::run(renderShadowTexture, shadowSpec(internalSettings, active ? 1.0 : 0.5));
+            g_pendingShadows.insert(key, pending);
+
+            // publish to the cache from the main thread
+            auto watcher = new QFutureWatcher<ShadowTexture>(provider);
+            const int version = snapshot->version;
+            QObject::connect(watcher, &QFutureWatcherBase::finished, provider, [watcher, key, version]() {
+                publishPrewarmedShadow(key, version);
+                watcher->deleteLater();
+            });
+            watcher->setFuture(pending.texture);
+        }
+    }
 
     //________________________________________________________________
     Decoration::Decoration(QObject *parent, const QVariantList &args)
         : KDecoration2::Decoration(parent, args)
-        , m_animation( new QVariantAnimation( this ) )
-        , m_shadowAnimation( new QVariantAnimation( this ) )
+        , m_animation( new Animation( this ) )
+        , m_shadowAnimation( new Animation( this ) )
     {
         g_sDecoCount++;
     }
@@ -155,8 +396,8 @@ namespace Breeze
     {
         g_sDecoCount--;
         if (g_sDecoCount == 0) {
-            // last deco destroyed, clean up shadow
-            g_sShadow.clear();
+            // last deco destroyed, clean up shadows
+            g_shadowCache.clear();
         }
 
         deleteSizeGrip();
@@ -225,70 +466,68 @@ namespace Breeze
         auto c = client().data();
 
         // active state change animation
-        // It is important start and end value are of the same type, hence 0.0 and not just 0
-        m_animation->setStartValue( 0.0 );
-        m_animation->setEndValue( 1.0 );
+        // animations are advanced by the shared ticker, which also merges repaints
         // Linear to have the same easing as Breeze animations
         m_animation->setEasingCurve( QEasingCurve::Linear );
-        connect(m_animation, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-            setOpacity(value.toReal());
+        connect(m_animation, &Animation::valueChanged, this, [this](qreal value) {
+            if( m_opacity == value ) return;
+            m_opacity = value;
+            AnimationTicker::self()->scheduleUpdate( this );
+            if( m_sizeGrip ) m_sizeGrip->update();
         });
 
-        m_shadowAnimation->setStartValue( 0.0 );
-        m_shadowAnimation->setEndValue( 1.0 );
         m_shadowAnimation->setEasingCurve( QEasingCurve::InCubic );
-        connect(m_shadowAnimation, &QVariantAnimation::valueChanged, this, [this](const QVariant& value) {
-            m_shadowOpacity = value.toReal();
-            updateShadow();
+        connect(m_shadowAnimation, &Animation::valueChanged, this, [this](qreal value) {
+            m_shadowOpacity = value;
+            scheduleUpdate( UpdateShadow );
         });
 
-        // use DBus connection to update on breeze configuration change
-        auto dbus = QDBusConnection::sessionBus();
-        dbus.connect( QString(),
-            QStringLiteral( "/KGlobalSettings" ),
-            QStringLiteral( "org.kde.KGlobalSettings" ),
-            QStringLiteral( "notifyChange" ), this, SLOT(reconfigure()) );
+        // configuration is parsed once by the settings provider, and shared by all decorations
+        connect(SettingsProvider::self(), &SettingsProvider::reconfigured, this, &Decoration::reconfigure);
 
         reconfigure();
         updateTitleBar();
+
+        // borders are recalculated immediately, other geometry changes are accumulated and applied once per event loop pass
         auto s = settings();
-        connect(s.data(), &KDecoration2::DecorationSettings::borderSizeChanged, this, &Decoration::recalculateBorders);
+        const auto bordersAndButtonsChanged = [this]() { recalculateBorders(); scheduleUpdate( UpdateTitleBar|UpdateButtons ); };
+        connect(s.data(), &KDecoration2::DecorationSettings::borderSizeChanged, this, [this]() { recalculateBorders(); scheduleUpdate( UpdateTitleBar ); });
 
-        // a change in font might cause the borders to change
-        connect(s.data(), &KDecoration2::DecorationSettings::fontChanged, this, &Decoration::recalculateBorders);
-        connect(s.data(), &KDecoration2::DecorationSettings::spacingChanged, this, &Decoration::recalculateBorders);
+        // a change in font or spacing might cause the borders and buttons to change
+        connect(s.data(), &KDecoration2::DecorationSettings::fontChanged, this, bordersAndButtonsChanged);
+        connect(s.data(), &KDecoration2::DecorationSettings::spacingChanged, this, bordersAndButtonsChanged);
 
         // buttons
-        connect(s.data(), &KDecoration2::DecorationSettings::spacingChanged, this, &Decoration::updateButtonsGeometryDelayed);
-        connect(s.data(), &KDecoration2::DecorationSettings::decorationButtonsLeftChanged, this, &Decoration::updateButtonsGeometryDelayed);
-        connect(s.data(), &KDecoration2::DecorationSettings::decorationButtonsRightChanged, this, &Decoration::updateButtonsGeometryDelayed);
+        const auto scheduleButtons = [this]() { scheduleUpdate( UpdateButtons ); };
+        connect(s.data(), &KDecoration2::DecorationSettings::decorationButtonsLeftChanged, this, scheduleButtons);
+        connect(s.data(), &KDecoration2::DecorationSettings::decorationButtonsRightChanged, this, scheduleButtons);
 
         // full reconfiguration
-        connect(s.data(), &KDecoration2::DecorationSettings::reconfigured, this, &Decoration::reconfigure);
         connect(s.data(), &KDecoration2::DecorationSettings::reconfigured, SettingsProvider::self(), &SettingsProvider::reconfigure, Qt::UniqueConnection );
-        connect(s.data(), &KDecoration2::DecorationSettings::reconfigured, this, &Decoration::updateButtonsGeometryDelayed);
+        connect(s.data(), &KDecoration2::DecorationSettings::reconfigured, this, scheduleButtons);
 
-        connect(c, &KDecoration2::DecoratedClient::adjacentScreenEdgesChanged, this, &Decoration::recalculateBorders);
+        connect(c, &KDecoration2::DecoratedClient::adjacentScreenEdgesChanged, this, [this]() { recalculateBorders(); scheduleUpdate( UpdateTitleBar|UpdateButtons|UpdateShadow ); });
         connect(c, &KDecoration2::DecoratedClient::maximizedHorizontallyChanged, this, &Decoration::recalculateBorders);
         connect(c, &KDecoration2::DecoratedClient::maximizedVerticallyChanged, this, &Decoration::recalculateBorders);
-        connect(c, &KDecoration2::DecoratedClient::shadedChanged, this, &Decoration::recalculateBorders);
+        connect(c, &KDecoration2::DecoratedClient::maximizedChanged, this, [this]() { scheduleUpdate( UpdateTitleBar|UpdateButtons|UpdateShadow ); });
+        connect(c, &KDecoration2::DecoratedClient::shadedChanged, this, [this]() { recalculateBorders(); scheduleUpdate( UpdateButtons ); });
         connect(c, &KDecoration2::DecoratedClient::captionChanged, this,
             [this]()
             {
                 // update the caption area
                 update(titleBar());
+
+                // window title based exceptions
+                if( SettingsProvider::self()->invalidateTitleMatch( this ) ) updateInternalSettings();
             }
         );
 
         connect(c, &KDecoration2::DecoratedClient::activeChanged, this, &Decoration::updateAnimationState);
-        connect(c, &KDecoration2::DecoratedClient::widthChanged, this, &Decoration::updateTitleBar);
-        connect(c, &KDecoration2::DecoratedClient::maximizedChanged, this, &Decoration::updateTitleBar);
         connect(c, &KDecoration2::DecoratedClient::maximizedChanged, this, &Decoration::setOpaque);
 
-        connect(c, &KDecoration2::DecoratedClient::widthChanged, this, &Decoration::updateButtonsGeometry);
-        connect(c, &KDecoration2::DecoratedClient::maximizedChanged, this, &Decoration::updateButtonsGeometry);
-        connect(c, &KDecoration2::DecoratedClient::adjacentScreenEdgesChanged, this, &Decoration::updateButtonsGeometry);
-        connect(c, &KDecoration2::DecoratedClient::shadedChanged, this, &Decoration::updateButtonsGeometry);
+        // interactive resize is kept synchronous, and only moves what depends on the width
+        connect(c, &KDecoration2::DecoratedClient::widthChanged, this, &Decoration::updateTitleBar);
+        connect(c, &KDecoration2::DecoratedClient::widthChanged, this, &Decoration::updateButtonsPositionResized);
 
         createButtons();
         updateShadow();
@@ -319,7 +558,7 @@ namespace Breeze
 
         } else {
 
-            updateShadow();
+            scheduleUpdate( UpdateShadow );
 
         }
 
@@ -387,26 +626,57 @@ namespace Breeze
     void Decoration::reconfigure()
     {
 
-        m_internalSettings = SettingsProvider::self()->internalSettings( this );
+        // nothing to do if the snapshot did not change
+        const auto snapshot = SettingsProvider::self()->snapshot();
+        if( snapshot->version == m_settingsVersion ) return;
+        m_settingsVersion = snapshot->version;
 
-        // animation
+        updateInternalSettings();
 
-        KSharedConfig::Ptr config = KSharedConfig::openConfig();
-        const KConfigGroup cg(config, QStringLiteral("KDE"));
+    }
 
+    //________________________________________________________________
+    void Decoration::updateInternalSettings()
+    {
+
+        const auto previous = m_internalSettings;
+        m_internalSettings = SettingsProvider::self()->internalSettings( this );
+        if( m_internalSettings == previous ) return;
+
+        // animation
         m_animation->setDuration(0);
         // Syncing anis between client and decoration is troublesome, so we're not using
         // any animations right now.
-        // m_animation->setDuration( cg.readEntry("AnimationDurationFactor", 1.0f) * 100.0f );
+        // m_animation->setDuration( SettingsProvider::self()->snapshot()->animationDurationFactor * 100.0f );
 
         // But the shadow is fine to animate like this!
-        m_shadowAnimation->setDuration( cg.readEntry("AnimationDurationFactor", 1.0f) * 100.0f );
+        // window specific settings may override the duration, for instance to disable it for video players
+        if( m_internalSettings->mask() & AnimationsDuration ) m_shadowAnimation->setDuration( m_internalSettings->animationsDuration() );
+        else m_shadowAnimation->setDuration( SettingsProvider::self()->snapshot()->animationDurationFactor * 100.0f );
 
-        // borders
-        recalculateBorders();
+        if( !previous )
+        {
 
-        // shadow
-        updateShadow();
+            // first configuration, everything needs to be computed
+            recalculateBorders();
+            updateShadow();
+
+        } else {
+
+            // borders
+            if( bordersChanged( *previous, *m_internalSettings ) )
+            {
+                recalculateBorders();
+                scheduleUpdate( UpdateTitleBar|UpdateButtons );
+            }
+
+            // shadow
+            if( shadowChanged( *previous, *m_internalSettings ) ) scheduleUpdate( UpdateShadow );
+
+            // colors, alignment and outlines
+            if( appearanceChanged( *previous, *m_internalSettings ) ) update();
+
+        }
 
         // size grip
         if( hasNoBorders() && m_internalSettings->drawSizeGrip() ) createSizeGrip();
@@ -471,8 +741,24 @@ namespace Breeze
     }
 
     //________________________________________________________________
-    void Decoration::updateButtonsGeometryDelayed()
-    { QTimer::singleShot( 0, this, &Decoration::updateButtonsGeometry ); }
+    void Decoration::scheduleUpdate( UpdateFlags flags )
+    {
+        // flush is only posted once per event loop pass
+        if( !m_pendingUpdates ) QTimer::singleShot( 0, this, &Decoration::flushUpdates );
+        m_pendingUpdates |= flags;
+    }
+
+    //________________________________________________________________
+    void Decoration::flushUpdates()
+    {
+        const UpdateFlags flags = m_pendingUpdates;
+        m_pendingUpdates = UpdateNone;
+
+        // borders are already up to date at this point
+        if( flags & UpdateTitleBar ) updateTitleBar();
+        if( flags & UpdateButtons ) updateButtonsGeometry();
+        if( flags & UpdateShadow ) updateShadow();
+    }
 
     //________________________________________________________________
     void Decoration::updateButtonsGeometry()
@@ -521,19 +807,17 @@ namespace Breeze
             // spacing
             m_rightButtons->setSpacing(s->smallSpacing()*Metrics::TitleBar_ButtonSpacing);
 
-            // padding
-            const int vPadding = isTopEdge() ? 0 : s->smallSpacing()*Metrics::TitleBar_TopMargin;
-            const int hPadding = s->smallSpacing()*Metrics::TitleBar_SideMargin;
             if( isRightEdge() )
             {
 
+                const int hPadding = s->smallSpacing()*Metrics::TitleBar_SideMargin;
                 auto button = static_cast<Button*>( m_rightButtons->buttons().back().data() );
                 button->setGeometry( QRectF( QPoint( 0, 0 ), QSizeF( bWidth + hPadding, bHeight ) ) );
                 button->setFlag( Button::FlagLastInList );
 
-                m_rightButtons->setPos(QPointF(size().width() - m_rightButtons->geometry().width(), vPadding));
+            }
 
-            } else m_rightButtons->setPos(QPointF(size().width() - m_rightButtons->geometry().width() - hPadding - borderRight(), vPadding));
+            updateRightButtonsPosition();
 
         }
 
@@ -541,6 +825,29 @@ namespace Breeze
 
     }
 
+    //________________________________________________________________
+    void Decoration::updateRightButtonsPosition()
+    {
+        if( m_rightButtons->buttons().isEmpty() ) return;
+
+        const auto s = settings();
+
+        // padding
+        const int vPadding = isTopEdge() ? 0 : s->smallSpacing()*Metrics::TitleBar_TopMargin;
+        const int hPadding = s->smallSpacing()*Metrics::TitleBar_SideMargin;
+        if( isRightEdge() ) m_rightButtons->setPos(QPointF(size().width() - m_rightButtons->geometry().width(), vPadding));
+        else m_rightButtons->setPos(QPointF(size().width() - m_rightButtons->geometry().width() - hPadding - borderRight(), vPadding));
+    }
+
+    //________________________________________________________________
+    void Decoration::updateButtonsPositionResized()
+    {
+        // only the right buttons and the caption depend on the window width.
+        // Button geometry is left untouched, since it is recomputed on all other relevant changes
+        updateRightButtonsPosition();
+        update( titleBar() );
+    }
+
     //________________________________________________________________
     void Decoration::paint(QPainter *painter, const QRect &repaintRegion)
     {
@@ -647,11 +954,17 @@ namespace Breeze
         painter->restore();
 
         // draw caption
+        // the caption is laid out once, and only again when caption, font or available width change
         painter->setFont(s->font());
         painter->setPen( fontColor() );
         const auto cR = captionRect();
-        const QString caption = painter->fontMetrics().elidedText(c->caption(), Qt::ElideMiddle, cR.first.width());
-        painter->drawText(cR.first, cR.second | Qt::TextSingleLine, caption);
+        const QStaticText& caption = captionText( cR.first.width() );
+
+        const QSizeF textSize( caption.size() );
+        QPointF position( cR.first.left(), cR.first.top() + ( cR.first.height() - textSize.height() )/2 );
+        if( cR.second & Qt::AlignRight ) position.setX( cR.first.left() + cR.first.width() - textSize.width() );
+        else if( cR.second & Qt::AlignHCenter ) position.setX( cR.first.left() + ( cR.first.width() - textSize.width() )/2 );
+        painter->drawStaticText( position, caption );
 
         // draw all buttons
         m_leftButtons->paint(painter, repaintRegion);
@@ -684,7 +997,6 @@ namespace Breeze
         if( hideTitleBar() ) return qMakePair( QRect(), Qt::AlignCenter );
         else {
 
-            auto c = client().data();
             const int leftOffset = m_leftButtons->buttons().isEmpty() ?
                 Metrics::TitleBar_SideMargin*settings()->smallSpacing():
                 m_leftButtons->geometry().x() + m_leftButtons->geometry().width() + Metrics::TitleBar_SideMargin*settings()->smallSpacing();
@@ -713,7 +1025,7 @@ namespace Breeze
 
                     // full caption rect
                     const QRect fullRect = QRect( 0, yOffset, size().width(), captionHeight() );
-                    QRect boundingRect( settings()->fontMetrics().boundingRect( c->caption()).toRect() );
+                    QRect boundingRect( captionBoundingRect() );
 
                     // text bounding rect
                     boundingRect.setTop( yOffset );
@@ -732,9 +1044,62 @@ namespace Breeze
 
     }
 
+    //________________________________________________________________
+    void Decoration::updateCaptionLayout() const
+    {
+        const QString caption( client().data()->caption() );
+        const QFont font( settings()->font() );
+        if( m_captionLayout.caption == caption && m_captionLayout.font == font ) return;
+
+        m_captionLayout.caption = caption;
+        m_captionLayout.font = font;
+        m_captionLayout.boundingRect = settings()->fontMetrics().boundingRect( caption ).toRect();
+
+        // elided text must be computed again
+        m_captionLayout.width = -1;
+    }
+
+    //________________________________________________________________
+    QRect Decoration::captionBoundingRect() const
+    {
+        updateCaptionLayout();
+        return m_captionLayout.boundingRect;
+    }
+
+    //________________________________________________________________
+    const QStaticText& Decoration::captionText( int width ) const
+    {
+        updateCaptionLayout();
+        if( m_captionLayout.width == width ) return m_captionLayout.text;
+
+        m_captionLayout.width = width;
+        m_captionLayout.text.setTextFormat( Qt::PlainText );
+        m_captionLayout.text.setPerformanceHint( QStaticText::AggressiveCaching );
+        m_captionLayout.text.setText( QFontMetrics( m_captionLayout.font ).elidedText( m_captionLayout.caption, Qt::ElideMiddle, width ) );
+        m_captionLayout.text.prepare( QTransform(), m_captionLayout.font );
+        return m_captionLayout.text;
+    }
+
+    //________________________________________________________________
+    bool Decoration::hasHiddenShadow() const
+    {
+        if( m_internalSettings->drawShadowOnMaximizedWindows() ) return false;
+
+        // maximized and tiled windows have their shadow off-screen, or covered by neighbours
+        auto c = client().data();
+        return c->isMaximized() || c->adjacentScreenEdges() != Qt::Edges();
+    }
+
     //________________________________________________________________
     void Decoration::updateShadow()
     {
+        // drop the shadow. Cached shadow objects are kept, and restored when needed
+        if( hasHiddenShadow() )
+        {
+            if( shadow() ) setShadow( QSharedPointer<KDecoration2::DecorationShadow>() );
+            return;
+        }
+
         // Animated case, no cached shadow object
         if ( (m_shadowAnimation->state() == QAbstractAnimation::Running) && (m_shadowOpacity != 0.0) && (m_shadowOpacity != 1.0) )
         {
@@ -742,99 +1107,35 @@ namespace Breeze
             return;
         }
 
-        if (g_shadowSizeEnum != m_internalSettings->shadowSize()
-                || g_shadowStrength != m_internalSettings->shadowStrength()
-                || g_shadowColor != m_internalSettings->shadowColor())
+        // cached shadows are dropped when the configuration changes
+        if (g_shadowCacheVersion != m_settingsVersion)
         {
-            g_sShadow.clear();
-            g_sShadowInactive.clear();
-            g_shadowSizeEnum = m_internalSettings->shadowSize();
-            g_shadowStrength = m_internalSettings->shadowStrength();
-            g_shadowColor = m_internalSettings->shadowColor();
+            clearShadowCache(m_settingsVersion);
         }
 
+        // window specific settings might use different shadows
         auto c = client().toStrongRef();
-        auto& shadow = (c->isActive()) ? g_sShadow : g_sShadowInactive;
-        if ( !shadow )
+        const quint64 key = shadowCacheKey(*m_internalSettings, c->isActive());
+
+        auto iter = g_shadowCache.find(key);
+        if (iter == g_shadowCache.end())
         {
-            shadow = createShadowObject(m_internalSettings, c->isActive() ? 1.0 : 0.5);
+            // waiting for a prewarmed shadow is cheaper than rendering it again
+            auto pending = g_pendingShadows.find(key);
+            if (pending != g_pendingShadows.end())
+            {
+                iter = g_shadowCache.insert(key, toShadowObject(pending->texture.result()));
+                g_pendingShadows.erase(pending);
+            } else {
+                iter = g_shadowCache.insert(key, createShadowObject(m_internalSettings, c->isActive() ? 1.0 : 0.5));
+            }
         }
-        setShadow(shadow);
+        setShadow(iter.value());
     }
 
     //________________________________________________________________
     QSharedPointer<KDecoration2::DecorationShadow> Decoration::createShadowObject(const InternalSettingsPtr& internalSettings, const float strengthScale)
-    {
-          const CompositeShadowParams params = lookupShadowParams(internalSettings->shadowSize());
-          if (params.isNone())
-          {
-              return nullptr;
-          }
-
-          auto withOpacity = [](const QColor& color, qreal opacity) -> QColor {
-              QColor c(color);
-              c.setAlphaF(opacity);
-              return c;
-          };
-
-
-          const QSize boxSize = BoxShadowRenderer::calculateMinimumBoxSize(params.shadow1.radius)
-              .expandedTo(BoxShadowRenderer::calculateMinimumBoxSize(params.shadow2.radius));
-
-          BoxShadowRenderer shadowRenderer;
-          shadowRenderer.setBorderRadius(Metrics::Frame_FrameRadius + 0.5);
-          shadowRenderer.setBoxSize(boxSize);
-          shadowRenderer.setDevicePixelRatio(1.0); // TODO: Create HiDPI shadows?
-
-          const qreal strength = internalSettings->shadowStrength() / 255.0 * strengthScale;
-          shadowRenderer.addShadow(params.shadow1.offset, params.shadow1.radius,
-              withOpacity(internalSettings->shadowColor(), params.shadow1.opacity * strength));
-          shadowRenderer.addShadow(params.shadow2.offset, params.shadow2.radius,
-              withOpacity(internalSettings->shadowColor(), params.shadow2.opacity * strength));
-
-          QImage shadowTexture = shadowRenderer.render();
-
-          QPainter painter(&shadowTexture);
-          painter.setRenderHint(QPainter::Antialiasing);
-
-          const QRect outerRect = shadowTexture.rect();
-
-          QRect boxRect(QPoint(0, 0), boxSize);
-          boxRect.moveCenter(outerRect.center());
-
-          // Mask out inner rect.
-          const QMargins padding = QMargins(
-              boxRect.left() - outerRect.left() - Metrics::Shadow_Overlap - params.offset.x(),
-              boxRect.top() - outerRect.top() - Metrics::Shadow_Overlap - params.offset.y(),
-              outerRect.right() - boxRect.right() - Metrics::Shadow_Overlap + params.offset.x(),
-              outerRect.bottom() - boxRect.bottom() - Metrics::Shadow_Overlap + params.offset.y());
-          const QRect innerRect = outerRect - padding;
-
-          painter.setPen(Qt::NoPen);
-          painter.setBrush(Qt::black);
-          painter.setCompositionMode(QPainter::CompositionMode_DestinationOut);
-          painter.drawRoundedRect(
-              innerRect,
-              Metrics::Frame_FrameRadius + 0.5,
-              Metrics::Frame_FrameRadius + 0.5);
-
-          // Draw outline.
-          painter.setPen(withOpacity(internalSettings->shadowColor(), 0.2 * strength));
-          painter.setBrush(Qt::NoBrush);
-          painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-          painter.drawRoundedRect(
-              innerRect,
-              Metrics::Frame_FrameRadius - 0.5,
-              Metrics::Frame_FrameRadius - 0.5);
-
-          painter.end();
-
-          auto ret = QSharedPointer<KDecoration2::DecorationShadow>::create();
-          ret->setPadding(padding);
-          ret->setInnerShadowRect(QRect(outerRect.center(), QSize(1, 1)));
-          ret->setShadow(shadowTexture);
-          return ret;
-    }
+    { return toShadowObject(renderShadowTexture(shadowSpec(*internalSettings, strengthScale))); }
 
     //_________________________________________________________________
     void Decoration::createSizeGrip()
@@ -9,17 +9,17 @@
  */
 
 #include "breeze.h"
+#include "breezeanimationticker.h"
 #include "breezesettings.h"
 
 #include <KDecoration2/Decoration>
 #include <KDecoration2/DecoratedClient>
 #include <KDecoration2/DecorationSettings>
 
+#include <QFont>
 #include <QPalette>
+#include <QStaticText>
 #include <QVariant>
-#include <QVariantAnimation>
-
-class QVariantAnimation;
 
 namespace KDecoration2
 {
@@ -45,6 +45,10 @@ namespace Breeze
         //* paint
         void paint(QPainter *painter, const QRect &repaintRegion) override;
 
+        //* render shadows for the default settings in worker threads, and add them to the shadow cache
+        /** called when the plugin is loaded, and each time the configuration changes. Shadows needed earlier are still rendered synchronously */
+        static void prewarmShadows();
+
         //* internal settings
         InternalSettingsPtr internalSettings() const
         { return m_internalSettings; }
@@ -74,6 +78,20 @@ namespace Breeze
         QColor fontColor() const;
         //@}
 
+        //* pending geometry updates. Borders are not part of it, since they are read synchronously by the compositor
+        enum UpdateFlag
+        {
+            UpdateNone = 0,
+            UpdateTitleBar = 1<<0,
+            UpdateButtons = 1<<1,
+            UpdateShadow = 1<<2
+        };
+
+        Q_DECLARE_FLAGS( UpdateFlags, UpdateFlag )
+
+        //* schedule title bar, buttons and shadow updates. They are applied once, at next event loop pass
+        void scheduleUpdate( UpdateFlags );
+
         //*@name maximization modes
         //@{
         inline bool isMaximized() const;
@@ -93,9 +111,12 @@ namespace Breeze
 
         private Q_SLOTS:
         void reconfigure();
+        void updateInternalSettings();
         void recalculateBorders();
         void updateButtonsGeometry();
-        void updateButtonsGeometryDelayed();
+        void flushUpdates();
+        void updateRightButtonsPosition();
+        void updateButtonsPositionResized();
         void updateTitleBar();
         void updateAnimationState();
         void updateSizeGripVisibility();
@@ -105,9 +126,24 @@ namespace Breeze
         //* return the rect in which caption will be drawn
         QPair<QRect,Qt::Alignment> captionRect() const;
 
+        //*@name caption layout
+        //@{
+
+        //* update cached caption layout if caption or font changed
+        void updateCaptionLayout() const;
+
+        //* caption bounding rect, at origin
+        QRect captionBoundingRect() const;
+
+        //* caption text, elided to fit in given width
+        const QStaticText& captionText( int width ) const;
+
+        //@}
+
         void createButtons();
         void paintTitleBar(QPainter *painter, const QRect &repaintRegion);
         void updateShadow();
+        bool hasHiddenShadow() const;
         static QSharedPointer<KDecoration2::DecorationShadow> createShadowObject(const InternalSettingsPtr& internalSettings, const float strengthScale);
 
         //*@name border size
@@ -127,6 +163,10 @@ namespace Breeze
         //@}
 
         InternalSettingsPtr m_internalSettings;
+
+        //* version of the settings snapshot used for last reconfiguration
+        int m_settingsVersion = -1;
+
         KDecoration2::DecorationButtonGroup *m_leftButtons = nullptr;
         KDecoration2::DecorationButtonGroup *m_rightButtons = nullptr;
 
@@ -134,13 +174,35 @@ namespace Breeze
         SizeGrip *m_sizeGrip = nullptr;
 
         //* active state change animation
-        QVariantAnimation *m_animation;
-        QVariantAnimation *m_shadowAnimation;
+        Animation *m_animation;
+        Animation *m_shadowAnimation;
 
         //* active state change opacity
         qreal m_opacity = 0;
         qreal m_shadowOpacity = 0;
 
+        //* pending geometry updates
+        UpdateFlags m_pendingUpdates = UpdateNone;
+
+        //* cached caption layout
+        class CaptionLayout
+        {
+            public:
+
+            //* caption and font
+            QString caption;
+            QFont font;
+
+            //* caption bounding rect
+            QRect boundingRect;
+
+            //* width used for eliding, and corresponding static text
+            int width = -1;
+            QStaticText text;
+        };
+
+        mutable CaptionLayout m_captionLayout;
+
     };
 
     bool Decoration::hasBorders() const
@@ -187,4 +249,6 @@ namespace Breeze
 
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( Breeze::Decoration::UpdateFlags )
+
 #endif
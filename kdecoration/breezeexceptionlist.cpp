@@ -10,39 +10,48 @@
 
 #include "breezeexceptionlist.h"
 
+#include <QSet>
+
 
 namespace Breeze
 {
 
     //______________________________________________________________
-    void ExceptionList::readConfig( KSharedConfig::Ptr config )
+    void ExceptionList::readConfig( KSharedConfig::Ptr config, InternalSettingsPtr base )
     {
 
         _exceptions.clear();
 
-        QString groupName;
-        for( int index = 0; config->hasGroup( groupName = exceptionGroupName( index ) ); ++index )
+        // load base configuration once, it is shared by all exceptions
+        if( !base )
         {
+            base = InternalSettingsPtr( new InternalSettings() );
+            base->load();
+        }
 
-            // create exception
-            InternalSettings exception;
+        // retrieve existing groups once, rather than probing them one by one
+        const QStringList groupList( config->groupList() );
+        const QSet<QString> groups( groupList.begin(), groupList.end() );
 
-            // reset group
-            readConfig( &exception, config.data(), groupName );
+        QString groupName;
+        for( int index = 0; groups.contains( groupName = exceptionGroupName( index ) ); ++index )
+        {
 
-            // create new configuration
+            // create new configuration from base
             InternalSettingsPtr configuration( new InternalSettings() );
-            configuration.data()->load();
+            copyConfig( base.data(), configuration.data() );
 
-            // apply changes from exception
-            configuration->setEnabled( exception.enabled() );
-            configuration->setExceptionType( exception.exceptionType() );
-            configuration->setExceptionPattern( exception.exceptionPattern() );
-            configuration->setMask( exception.mask() );
+            // overlay exception specific settings
+            readConfig( configuration.data(), config.data(), groupName );
 
-            // propagate all features found in mask to the output configuration
-            if( exception.mask() & BorderSize ) configuration->setBorderSize( exception.borderSize() );
-            configuration->setHideTitleBar( exception.hideTitleBar() );
+            // masked features are only propagated if found in mask
+            for( const auto& maskedKey : maskedKeys() )
+            {
+                if( configuration->mask() & maskedKey.first ) continue;
+                KConfigSkeletonItem* item( configuration->findItem( maskedKey.second ) );
+                const KConfigSkeletonItem* baseItem( base->findItem( maskedKey.second ) );
+                if( item && baseItem ) item->setProperty( baseItem->property() );
+            }
 
             // append to exceptions
             _exceptions.append( configuration );
@@ -76,15 +85,32 @@ namespace Breeze
     QString ExceptionList::exceptionGroupName( int index )
     { return QString( "Windeco Exception %1" ).arg( index ); }
 
+    //_______________________________________________________________________
+    const QStringList& ExceptionList::exceptionKeys()
+    {
+        static const QStringList keys = { "Enabled", "ExceptionPattern", "ExceptionType", "HideTitleBar", "Mask", "BorderSize", "ShadowSize", "ShadowStrength", "AnimationsDuration"};
+        return keys;
+    }
+
+    //_______________________________________________________________________
+    const QList<QPair<ExceptionMask, QString>>& ExceptionList::maskedKeys()
+    {
+        static const QList<QPair<ExceptionMask, QString>> keys = {
+            { BorderSize, "BorderSize" },
+            { ShadowSize, "ShadowSize" },
+            { ShadowStrength, "ShadowStrength" },
+            { AnimationsDuration, "AnimationsDuration" }
+        };
+
+        return keys;
+    }
+
     //______________________________________________________________
     void ExceptionList::writeConfig( KCoreConfigSkeleton* skeleton, KConfig* config, const QString& groupName )
     {
 
-        // list of items to be written
-        QStringList keys = { "Enabled", "ExceptionPattern", "ExceptionType", "HideTitleBar", "Mask", "BorderSize"};
-
         // write all items
-        foreach( auto key, keys )
+        foreach( auto key, exceptionKeys() )
         {
             KConfigSkeletonItem* item( skeleton->findItem( key ) );
             if( !item ) continue;
@@ -101,12 +127,30 @@ namespace Breeze
     void ExceptionList::readConfig( KCoreConfigSkeleton* skeleton, KConfig* config, const QString& groupName )
     {
 
-        foreach( KConfigSkeletonItem* item, skeleton->items() )
+        // only exception specific items are read, others are inherited from the base configuration
+        foreach( auto key, exceptionKeys() )
         {
+            KConfigSkeletonItem* item( skeleton->findItem( key ) );
+            if( !item ) continue;
+
             if( !groupName.isEmpty() ) item->setGroup( groupName );
             item->readConfig( config );
         }
 
     }
 
+    //______________________________________________________________
+    void ExceptionList::copyConfig( const KCoreConfigSkeleton* source, KCoreConfigSkeleton* destination )
+    {
+
+        // both skeletons are of the same type, so that items come in the same order
+        const auto sourceItems( source->items() );
+        const auto destinationItems( destination->items() );
+        Q_ASSERT( sourceItems.size() == destinationItems.size() );
+
+        for( int i = 0; i < sourceItems.size() && i < destinationItems.size(); ++i )
+        { destinationItems[i]->setProperty( sourceItems[i]->property() ); }
+
+    }
+
 }
@@ -16,6 +16,8 @@
 
 #include <KSharedConfig>
 
+#include <QPair>
+
 namespace Breeze
 {
 
@@ -35,7 +37,11 @@ namespace Breeze
         { return _exceptions; }
 
         //! read from KConfig
-        void readConfig( KSharedConfig::Ptr );
+        /*!
+        exceptions are built as overlays of the base configuration.
+        If no base configuration is passed, it is loaded once for all exceptions
+        */
+        void readConfig( KSharedConfig::Ptr, InternalSettingsPtr base = InternalSettingsPtr() );
 
         //! write to kconfig
         void writeConfig( KSharedConfig::Ptr );
@@ -45,9 +51,18 @@ namespace Breeze
         //! generate exception group name for given exception index
         static QString exceptionGroupName( int index );
 
-        //! read configuration
+        //! keys stored in exception groups
+        static const QStringList& exceptionKeys();
+
+        //! keys that are only overridden when found in the exception mask
+        static const QList<QPair<ExceptionMask, QString>>& maskedKeys();
+
+        //! read exception specific configuration
         static void readConfig( KCoreConfigSkeleton*, KConfig*, const QString& );
 
+        //! copy all values from one configuration to another of the same type
+        static void copyConfig( const KCoreConfigSkeleton*, KCoreConfigSkeleton* );
+
         //! write configuration
         static void writeConfig( KCoreConfigSkeleton*, KConfig*, const QString& );
 
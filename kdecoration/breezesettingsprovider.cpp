@@ -8,8 +8,10 @@
 
 #include "breezeexceptionlist.h"
 
+#include <KConfigGroup>
 #include <KWindowInfo>
 
+#include <QDBusConnection>
 #include <QTextStream>
 
 namespace Breeze
@@ -20,7 +22,16 @@ namespace Breeze
     //__________________________________________________________________
     SettingsProvider::SettingsProvider():
         m_config( KSharedConfig::openConfig( QStringLiteral("breezerc") ) )
-    { reconfigure(); }
+    {
+        reconfigure();
+
+        // use DBus connection to update on breeze configuration change
+        auto dbus = QDBusConnection::sessionBus();
+        dbus.connect( QString(),
+            QStringLiteral( "/KGlobalSettings" ),
+            QStringLiteral( "org.kde.KGlobalSettings" ),
+            QStringLiteral( "notifyChange" ), this, SLOT(reconfigure()) );
+    }
 
     //__________________________________________________________________
     SettingsProvider::~SettingsProvider()
@@ -39,45 +50,126 @@ namespace Breeze
     //__________________________________________________________________
     void SettingsProvider::reconfigure()
     {
-        if( !m_defaultSettings )
+
+        // configuration is parsed once, and shared by all decorations
+        auto snapshot = QSharedPointer<SettingsSnapshot>::create();
+        snapshot->version = m_snapshot ? m_snapshot->version + 1 : 0;
+
+        snapshot->defaultSettings = InternalSettingsPtr(new InternalSettings());
+        snapshot->defaultSettings->setCurrentGroup( QStringLiteral("Windeco") );
+        snapshot->defaultSettings->load();
+
+        ExceptionList exceptions;
+        exceptions.readConfig( m_config, snapshot->defaultSettings );
+        snapshot->exceptions = exceptions.get();
+
+        // compile exception patterns
+        foreach( auto internalSettings, snapshot->exceptions )
         {
-            m_defaultSettings = InternalSettingsPtr(new InternalSettings());
-            m_defaultSettings->setCurrentGroup( QStringLiteral("Windeco") );
+            // disabled exceptions and exceptions with empty exception pattern are discarded
+            if( !internalSettings->enabled() || internalSettings->exceptionPattern().isEmpty() )
+            {
+                snapshot->patterns.append( QRegExp() );
+                continue;
+            }
+
+            snapshot->patterns.append( QRegExp( internalSettings->exceptionPattern() ) );
+            if( internalSettings->exceptionType() == InternalSettings::ExceptionWindowTitle )
+            { snapshot->hasTitleExceptions = true; }
+
         }
 
-        m_defaultSettings->load();
+        // exception matches are kept as long as matching rules are unchanged
+        if( !m_snapshot ) snapshot->exceptionsVersion = 0;
+        else if( sameMatchingRules( m_snapshot->exceptions, snapshot->exceptions ) ) snapshot->exceptionsVersion = m_snapshot->exceptionsVersion;
+        else snapshot->exceptionsVersion = m_snapshot->exceptionsVersion + 1;
 
-        ExceptionList exceptions;
-        exceptions.readConfig( m_config );
-        m_exceptions = exceptions.get();
+        // animation
+        const KConfigGroup cg( KSharedConfig::openConfig(), QStringLiteral("KDE") );
+        snapshot->animationDurationFactor = cg.readEntry( "AnimationDurationFactor", 1.0f );
+
+        m_snapshot = snapshot;
+        emit reconfigured();
+
+    }
+
+    //__________________________________________________________________
+    bool SettingsProvider::sameMatchingRules( const InternalSettingsList& first, const InternalSettingsList& second )
+    {
+        if( first.size() != second.size() ) return false;
+        for( int index = 0; index < first.size(); ++index )
+        {
+            if( first[index]->enabled() != second[index]->enabled() ||
+                first[index]->exceptionType() != second[index]->exceptionType() ||
+                first[index]->exceptionPattern() != second[index]->exceptionPattern() )
+            { return false; }
+        }
 
+        return true;
+    }
+
+    //__________________________________________________________________
+    bool SettingsProvider::invalidateTitleMatch( const Decoration *decoration )
+    {
+        if( !m_snapshot->hasTitleExceptions ) return false;
+
+        auto iter = m_matches.find( decoration );
+        if( iter != m_matches.end() ) iter->exceptionsVersion = -1;
+        return true;
     }
 
     //__________________________________________________________________
     InternalSettingsPtr SettingsProvider::internalSettings( Decoration *decoration ) const
+    {
+
+        // find cached match
+        auto iter = m_matches.find( decoration );
+        if( iter == m_matches.end() )
+        {
+            iter = m_matches.insert( decoration, ExceptionMatch() );
+            connect( decoration, &QObject::destroyed, this, [this, decoration]() { m_matches.remove( decoration ); } );
+        }
+
+        auto& match( iter.value() );
+        if( match.exceptionsVersion != m_snapshot->exceptionsVersion )
+        {
+            // window class is read again, at most once, whenever exceptions are reconfigured
+            if( match.classNameVersion != m_snapshot->exceptionsVersion )
+            {
+                match.classNameVersion = m_snapshot->exceptionsVersion;
+                match.className.clear();
+            }
+
+            match.exceptionsVersion = m_snapshot->exceptionsVersion;
+            match.index = findException( decoration, match.className );
+        }
+
+        return match.index >= 0 ? m_snapshot->exceptions[match.index] : m_snapshot->defaultSettings;
+
+    }
+
+    //__________________________________________________________________
+    int SettingsProvider::findException( Decoration *decoration, QString &className ) const
     {
 
         QString windowTitle;
-        QString className;
 
         // get the client
         auto client = decoration->client().data();
 
-        foreach( auto internalSettings, m_exceptions )
+        for( int index = 0; index < m_snapshot->exceptions.size(); ++index )
         {
 
-            // discard disabled exceptions
-            if( !internalSettings->enabled() ) continue;
-
-            // discard exceptions with empty exception pattern
-            if( internalSettings->exceptionPattern().isEmpty() ) continue;
+            // discard disabled exceptions and exceptions with empty exception pattern
+            const auto& pattern( m_snapshot->patterns[index] );
+            if( pattern.isEmpty() ) continue;
 
             /*
             decide which value is to be compared
             to the regular expression, based on exception type
             */
             QString value;
-            switch( internalSettings->exceptionType() )
+            switch( m_snapshot->exceptions[index]->exceptionType() )
             {
                 case InternalSettings::ExceptionWindowTitle:
                 {
@@ -88,6 +180,7 @@ namespace Breeze
                 default:
                 case InternalSettings::ExceptionWindowClassName:
                 {
+                    // class name is retrieved once, and cached with the match
                     if( className.isEmpty() )
                     {
                         // retrieve class name
@@ -104,12 +197,12 @@ namespace Breeze
             }
 
             // check matching
-            if( QRegExp( internalSettings->exceptionPattern() ).indexIn( value ) >= 0 )
-            { return internalSettings; }
+            if( pattern.indexIn( value ) >= 0 )
+            { return index; }
 
         }
 
-        return m_defaultSettings;
+        return -1;
 
     }
 
@@ -12,11 +12,48 @@
 
 #include <KSharedConfig>
 
+#include <QHash>
 #include <QObject>
+#include <QRegExp>
+#include <QVector>
 
 namespace Breeze
 {
 
+    //* immutable configuration, shared by all decorations
+    /**
+    a new snapshot is created each time the configuration is parsed.
+    Decorations keep a pointer to the snapshot they were configured with,
+    so that nothing is re-read when it did not change.
+    */
+    class SettingsSnapshot
+    {
+
+        public:
+
+        //* version, incremented at each reconfiguration
+        int version = 0;
+
+        //* default configuration
+        InternalSettingsPtr defaultSettings;
+
+        //* exceptions
+        InternalSettingsList exceptions;
+
+        //* compiled exception patterns, in the same order as exceptions. Empty for discarded exceptions
+        QVector<QRegExp> patterns;
+
+        //* version of the exception matching rules. Only incremented when these change
+        int exceptionsVersion = 0;
+
+        //* true if some exceptions are matched against window title
+        bool hasTitleExceptions = false;
+
+        //* global animation duration factor
+        qreal animationDurationFactor = 1.0;
+
+    };
+
     class SettingsProvider: public QObject
     {
 
@@ -30,24 +67,62 @@ namespace Breeze
         //* singleton
         static SettingsProvider *self();
 
+        //* current configuration snapshot
+        SettingsSnapshotPtr snapshot() const
+        { return m_snapshot; }
+
         //* internal settings for given decoration
+        /** the matching exception is cached per decoration, until matching rules change */
         InternalSettingsPtr internalSettings(Decoration *) const;
 
+        //* invalidate cached exception match after a caption change
+        /** returns false, and does nothing, if no exception depends on window title */
+        bool invalidateTitleMatch( const Decoration* );
+
         public Q_SLOTS:
 
         //* reconfigure
         void reconfigure();
 
+        Q_SIGNALS:
+
+        //* emitted when a new snapshot is available
+        void reconfigured();
+
         private:
 
         //* constructor
         SettingsProvider();
 
-        //* default configuration
-        InternalSettingsPtr m_defaultSettings;
+        //* true if both exception lists match the same windows
+        static bool sameMatchingRules( const InternalSettingsList&, const InternalSettingsList& );
 
-        //* exceptions
-        InternalSettingsList m_exceptions;
+        //* index of the first exception matching a decoration, or -1. Class name is retrieved if empty
+        int findException( Decoration*, QString& className ) const;
+
+        //* current snapshot
+        SettingsSnapshotPtr m_snapshot;
+
+        //* cached exception match
+        class ExceptionMatch
+        {
+            public:
+
+            //* exception matching rules version
+            int exceptionsVersion = -1;
+
+            //* exceptions version the class name was read for
+            int classNameVersion = -1;
+
+            //* window class name, as used for matching. Cleared when exceptions are reconfigured
+            QString className;
+
+            //* matched exception index, or -1
+            int index = -1;
+        };
+
+        //* exception match, per decoration
+        mutable QHash<const Decoration*, ExceptionMatch> m_matches;
 
         //* config object
         KSharedConfigPtr m_config;
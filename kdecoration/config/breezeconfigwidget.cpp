@@ -41,6 +41,7 @@ namespace Breeze
         connect( m_ui.shadowSize, SIGNAL(currentIndexChanged(int)), SLOT(updateChanged()) );
         connect( m_ui.shadowStrength, SIGNAL(valueChanged(int)), SLOT(updateChanged()) );
         connect( m_ui.shadowColor, &KColorButton::changed, this, &ConfigWidget::updateChanged );
+        connect( m_ui.drawShadowOnMaximizedWindows, &QAbstractButton::clicked, this, &ConfigWidget::updateChanged );
 
         // track exception changes
         connect( m_ui.exceptions, &ExceptionListWidget::changed, this, &ConfigWidget::updateChanged );
@@ -70,6 +71,7 @@ namespace Breeze
 
         m_ui.shadowStrength->setValue( qRound(qreal(m_internalSettings->shadowStrength()*100)/255 ) );
         m_ui.shadowColor->setColor( m_internalSettings->shadowColor() );
+        m_ui.drawShadowOnMaximizedWindows->setChecked( m_internalSettings->drawShadowOnMaximizedWindows() );
 
         // load exceptions
         ExceptionList exceptions;
@@ -99,6 +101,7 @@ namespace Breeze
         m_internalSettings->setShadowSize( m_ui.shadowSize->currentIndex() );
         m_internalSettings->setShadowStrength( qRound( qreal(m_ui.shadowStrength->value()*255)/100 ) );
         m_internalSettings->setShadowColor( m_ui.shadowColor->color() );
+        m_internalSettings->setDrawShadowOnMaximizedWindows( m_ui.drawShadowOnMaximizedWindows->isChecked() );
 
         // save configuration
         m_internalSettings->save();
@@ -145,6 +148,7 @@ namespace Breeze
         m_ui.shadowSize->setCurrentIndex( m_internalSettings->shadowSize() );
         m_ui.shadowStrength->setValue( qRound(qreal(m_internalSettings->shadowStrength()*100)/255 ) );
         m_ui.shadowColor->setColor( m_internalSettings->shadowColor() );
+        m_ui.drawShadowOnMaximizedWindows->setChecked( m_internalSettings->drawShadowOnMaximizedWindows() );
 
     }
 
@@ -170,6 +174,7 @@ namespace Breeze
         else if( m_ui.shadowSize->currentIndex() !=  m_internalSettings->shadowSize() ) modified = true;
         else if( qRound( qreal(m_ui.shadowStrength->value()*255)/100 ) != m_internalSettings->shadowStrength() ) modified = true;
         else if( m_ui.shadowColor->color() != m_internalSettings->shadowColor() ) modified = true;
+        else if( m_ui.drawShadowOnMaximizedWindows->isChecked() != m_internalSettings->drawShadowOnMaximizedWindows() ) modified = true;
 
         // exceptions
         else if( m_ui.exceptions->isChanged() ) modified = true;
@@ -29,6 +29,9 @@ namespace Breeze
 
         // store checkboxes from ui into list
         m_checkboxes.insert( BorderSize, m_ui.borderSizeCheckBox );
+        m_checkboxes.insert( ShadowSize, m_ui.shadowSizeCheckBox );
+        m_checkboxes.insert( ShadowStrength, m_ui.shadowStrengthCheckBox );
+        m_checkboxes.insert( AnimationsDuration, m_ui.animationsDurationCheckBox );
 
         // detect window properties
         connect( m_ui.detectDialogButton, &QAbstractButton::clicked, this, &ExceptionDialog::selectWindowProperties );
@@ -37,6 +40,9 @@ namespace Breeze
         connect( m_ui.exceptionType, SIGNAL(currentIndexChanged(int)), SLOT(updateChanged()) );
         connect( m_ui.exceptionEditor, &QLineEdit::textChanged, this, &ExceptionDialog::updateChanged );
         connect( m_ui.borderSizeComboBox, SIGNAL(currentIndexChanged(int)), SLOT(updateChanged()) );
+        connect( m_ui.shadowSizeComboBox, SIGNAL(currentIndexChanged(int)), SLOT(updateChanged()) );
+        connect( m_ui.shadowStrengthSpinBox, SIGNAL(valueChanged(int)), SLOT(updateChanged()) );
+        connect( m_ui.animationsDurationSpinBox, SIGNAL(valueChanged(int)), SLOT(updateChanged()) );
 
         for( CheckBoxMap::iterator iter = m_checkboxes.begin(); iter != m_checkboxes.end(); ++iter )
         { connect( iter.value(), &QAbstractButton::clicked, this, &ExceptionDialog::updateChanged ); }
@@ -62,6 +68,9 @@ namespace Breeze
         m_ui.exceptionType->setCurrentIndex(m_exception->exceptionType() );
         m_ui.exceptionEditor->setText( m_exception->exceptionPattern() );
         m_ui.borderSizeComboBox->setCurrentIndex( m_exception->borderSize() );
+        m_ui.shadowSizeComboBox->setCurrentIndex( m_exception->shadowSize() );
+        m_ui.shadowStrengthSpinBox->setValue( qRound(qreal(m_exception->shadowStrength()*100)/255 ) );
+        m_ui.animationsDurationSpinBox->setValue( m_exception->animationsDuration() );
         m_ui.hideTitleBar->setChecked( m_exception->hideTitleBar() );
 
         // mask
@@ -78,6 +87,9 @@ namespace Breeze
         m_exception->setExceptionType( m_ui.exceptionType->currentIndex() );
         m_exception->setExceptionPattern( m_ui.exceptionEditor->text() );
         m_exception->setBorderSize( m_ui.borderSizeComboBox->currentIndex() );
+        m_exception->setShadowSize( m_ui.shadowSizeComboBox->currentIndex() );
+        m_exception->setShadowStrength( qRound( qreal(m_ui.shadowStrengthSpinBox->value()*255)/100 ) );
+        m_exception->setAnimationsDuration( m_ui.animationsDurationSpinBox->value() );
         m_exception->setHideTitleBar( m_ui.hideTitleBar->isChecked() );
 
         // mask
@@ -98,6 +110,9 @@ namespace Breeze
         if( m_exception->exceptionType() != m_ui.exceptionType->currentIndex() ) modified = true;
         else if( m_exception->exceptionPattern() != m_ui.exceptionEditor->text() ) modified = true;
         else if( m_exception->borderSize() != m_ui.borderSizeComboBox->currentIndex() ) modified = true;
+        else if( m_exception->shadowSize() != m_ui.shadowSizeComboBox->currentIndex() ) modified = true;
+        else if( m_exception->shadowStrength() != qRound( qreal(m_ui.shadowStrengthSpinBox->value()*255)/100 ) ) modified = true;
+        else if( m_exception->animationsDuration() != m_ui.animationsDurationSpinBox->value() ) modified = true;
         else if( m_exception->hideTitleBar() != m_ui.hideTitleBar->isChecked() ) modified = true;
         else
         {
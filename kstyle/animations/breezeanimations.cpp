@@ -7,6 +7,7 @@
 #include "breezeanimations.h"
 #include "breezepropertynames.h"
 #include "breezestyleconfigdata.h"
+#include "breezewidgettraits.h"
 
 #include <QAbstractItemView>
 #include <QComboBox>
@@ -100,83 +101,81 @@ namespace Breeze
         _widgetEnabilityEngine->registerWidget( widget, AnimationEnable );
 
         // install animation timers
-        // for optimization, one should put with most used widgets here first
-
-        // buttons
-        if( qobject_cast<QToolButton*>(widget) )
+        // engine is selected from class-wide traits
+        switch( WidgetTraits::get( widget ).animation )
         {
 
+            // buttons
+            case WidgetTraits::AnimateToolButton:
             _toolButtonEngine->registerWidget( widget, AnimationHover|AnimationFocus );
             _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus );
+            break;
 
-        } else if( qobject_cast<QCheckBox*>(widget) || qobject_cast<QRadioButton*>(widget) ) {
-
+            case WidgetTraits::AnimateCheckBox:
             _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus|AnimationPressed );
+            break;
 
-        } else if( qobject_cast<QAbstractButton*>(widget) ) {
-
-            // register to toolbox engine if needed
-            if( qobject_cast<QToolBox*>( widget->parent() ) )
-            { _toolBoxEngine->registerWidget( widget ); }
+            case WidgetTraits::AnimateButton:
+            {
+                // register to toolbox engine if needed
+                if( WidgetTraits::get( widget->parent() ).is( WidgetTraits::ToolBox ) )
+                { _toolBoxEngine->registerWidget( widget ); }
 
-            _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus );
-
-        }
+                _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus );
+                break;
+            }
 
-        // groupboxes
-        else if( QGroupBox* groupBox = qobject_cast<QGroupBox*>( widget ) )
-        {
-            if( groupBox->isCheckable() )
+            // groupboxes
+            case WidgetTraits::AnimateGroupBox:
+            if( static_cast<QGroupBox*>( widget )->isCheckable() )
             { _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        }
+            break;
 
-        // sliders
-        else if( qobject_cast<QScrollBar*>( widget ) ) { _scrollBarEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        else if( qobject_cast<QSlider*>( widget ) ) { _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        else if( qobject_cast<QDial*>( widget ) ) { _dialEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+            // sliders
+            case WidgetTraits::AnimateScrollBar: _scrollBarEngine->registerWidget( widget, AnimationHover|AnimationFocus ); break;
+            case WidgetTraits::AnimateSlider: _widgetStateEngine->registerWidget( widget, AnimationHover|AnimationFocus ); break;
+            case WidgetTraits::AnimateDial: _dialEngine->registerWidget( widget, AnimationHover|AnimationFocus ); break;
 
-        // progress bar
-        else if( qobject_cast<QProgressBar*>( widget ) ) { _busyIndicatorEngine->registerWidget( widget ); }
+            // progress bar
+            case WidgetTraits::AnimateProgressBar: _busyIndicatorEngine->registerWidget( widget ); break;
 
-        // combo box
-        else if( qobject_cast<QComboBox*>( widget ) ) {
+            // combo box
+            case WidgetTraits::AnimateComboBox:
             _comboBoxEngine->registerWidget( widget, AnimationHover );
             _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus );
-        }
+            break;
 
-        // spinbox
-        else if( qobject_cast<QSpinBox*>( widget ) ) {
+            // spinbox
+            case WidgetTraits::AnimateSpinBox:
             _spinBoxEngine->registerWidget( widget );
             _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus );
-        }
-
-        // editors
-        else if( qobject_cast<QLineEdit*>( widget ) ) { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        else if( qobject_cast<QTextEdit*>( widget ) ) { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
-        else if( widget->inherits( "KTextEditor::View" ) ) { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+            break;
 
-        // header views
-        // need to come before abstract item view, otherwise is skipped
-        else if( qobject_cast<QHeaderView*>( widget ) ) { _headerViewEngine->registerWidget( widget ); }
+            // editors and lists
+            case WidgetTraits::AnimateInputWidget: _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); break;
 
-        // lists
-        else if( qobject_cast<QAbstractItemView*>( widget ) )
-        { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+            // header views
+            case WidgetTraits::AnimateHeaderView: _headerViewEngine->registerWidget( widget ); break;
 
-        // tabbar
-        else if( qobject_cast<QTabBar*>( widget ) ) { _tabBarEngine->registerWidget( widget ); }
+            // tabbar
+            case WidgetTraits::AnimateTabBar: _tabBarEngine->registerWidget( widget ); break;
 
-        // scrollarea
-        else if( QAbstractScrollArea* scrollArea = qobject_cast<QAbstractScrollArea*>( widget ) ) {
+            // scrollarea
+            case WidgetTraits::AnimateScrollArea:
+            {
+                auto scrollArea = static_cast<QAbstractScrollArea*>( widget );
+                if( scrollArea->frameShadow() == QFrame::Sunken && (widget->focusPolicy()&Qt::StrongFocus) )
+                { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+                break;
+            }
 
-            if( scrollArea->frameShadow() == QFrame::Sunken && (widget->focusPolicy()&Qt::StrongFocus) )
-            { _inputWidgetEngine->registerWidget( widget, AnimationHover|AnimationFocus ); }
+            default: break;
 
         }
 
         // stacked widgets
-        if( QStackedWidget* stack = qobject_cast<QStackedWidget*>( widget ) )
-        { _stackedWidgetEngine->registerWidget( stack ); }
+        if( WidgetTraits::get( widget ).is( WidgetTraits::StackedWidget ) )
+        { _stackedWidgetEngine->registerWidget( static_cast<QStackedWidget*>( widget ) ); }
 
         
     }
@@ -13,12 +13,37 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "breezeblurhelper.h"
+#include "breezemetrics.h"
 #include "breezestyleconfigdata.h"
 
 #include <KWindowEffects>
 
 #include <QEvent>
+#include <QTimerEvent>
 #include <QVector>
+#include <QtMath>
+
+namespace
+{
+    //! region covering a rounded rect, one rect per row in the corners
+    QRegion roundedRegion(const QRect& rect, int radius)
+    {
+        radius = qMin(radius, qMin(rect.width(), rect.height())/2);
+        if (radius <= 0) return QRegion(rect);
+
+        QRegion region(rect.adjusted(0, radius, 0, -radius));
+        for (int i = 0; i < radius; ++i) {
+            // horizontal inset of the row, measured at pixel center
+            const qreal dy(radius - i - 0.5);
+            const int inset(qRound(radius - qSqrt(radius*radius - dy*dy)));
+            const int width(rect.width() - 2*inset);
+            region += QRect(rect.left() + inset, rect.top() + i, width, 1);
+            region += QRect(rect.left() + inset, rect.bottom() - i, width, 1);
+        }
+
+        return region;
+    }
+}
 
 namespace Breeze
 {
@@ -34,6 +59,9 @@ namespace Breeze
         // install event filter
         addEventFilter(widget);
 
+        // catch object destruction
+        connect(widget, &QObject::destroyed, this, &BlurHelper::widgetDestroyed, Qt::UniqueConnection);
+
         // schedule shadow area repaint
         update(widget);
     }
@@ -43,6 +71,8 @@ namespace Breeze
     {
         // remove event filter
         widget->removeEventFilter(this);
+        disconnect(widget, &QObject::destroyed, this, &BlurHelper::widgetDestroyed);
+        widgetDestroyed(widget);
     }
 
     //___________________________________________________________
@@ -50,8 +80,13 @@ namespace Breeze
     {
         switch (event->type()) {
             case QEvent::Hide:
+            {
+                // the native window might be destroyed, or its blur reset, while hidden
+                _sentRegions.remove(object);
+                break;
+            }
+
             case QEvent::Show:
-            case QEvent::Resize:
             {
                 // cast to widget and check
                 QWidget* widget(qobject_cast<QWidget*>(object));
@@ -59,10 +94,24 @@ namespace Breeze
                 if (!widget)
                     break;
 
+                // the blur region must be set before the window is mapped
+                _pendingWidgets.remove(widget);
                 update(widget);
                 break;
             }
 
+            case QEvent::Resize:
+            {
+                // cast to widget and check
+                QWidget* widget(qobject_cast<QWidget*>(object));
+
+                if (!widget)
+                    break;
+
+                scheduleUpdate(widget);
+                break;
+            }
+
             default: break;
         }
 
@@ -71,7 +120,33 @@ namespace Breeze
     }
 
     //___________________________________________________________
-    void BlurHelper::update(QWidget* widget) const
+    void BlurHelper::timerEvent(QTimerEvent* event)
+    {
+        if (event->timerId() != _timer.timerId()) {
+            QObject::timerEvent(event);
+            return;
+        }
+
+        _timer.stop();
+
+        const auto widgets(_pendingWidgets);
+        _pendingWidgets.clear();
+        for (QWidget* widget : widgets) {
+            update(widget);
+        }
+    }
+
+    //___________________________________________________________
+    void BlurHelper::scheduleUpdate(QWidget* widget)
+    {
+        _pendingWidgets.insert(widget);
+        if (!_timer.isActive()) {
+            _timer.start(0, this);
+        }
+    }
+
+    //___________________________________________________________
+    void BlurHelper::update(QWidget* widget)
     {
         /*
         directly from bespin code. Supposedly prevent playing with some 'pseudo-widgets'
@@ -80,11 +155,33 @@ namespace Breeze
         if (!(widget->testAttribute(Qt::WA_WState_Created) || widget->internalWinId()))
             return;
 
-        KWindowEffects::enableBlurBehind(widget->winId(), true);
+        // only send the region when it changed, or when the native window changed
+        const QRegion region(blurRegion(widget));
+        BlurState& state(_sentRegions[widget]);
+        if (state.winId == widget->winId() && state.region == region)
+            return;
+
+        state.winId = widget->winId();
+        state.region = region;
+        KWindowEffects::enableBlurBehind(state.winId, true, region);
 
         // force update
         if (widget->isVisible()) {
             widget->update();
         }
     }
+
+    //___________________________________________________________
+    QRegion BlurHelper::blurRegion(QWidget* widget) const
+    {
+        // translucent menus are rendered with rounded corners
+        return roundedRegion(widget->rect(), Metrics::Frame_FrameRadius);
+    }
+
+    //___________________________________________________________
+    void BlurHelper::widgetDestroyed(QObject* object)
+    {
+        _sentRegions.remove(object);
+        _pendingWidgets.remove(static_cast<QWidget*>(object));
+    }
 }
@@ -18,8 +18,11 @@
 #include "breeze.h"
 #include "breezehelper.h"
 
+#include <QBasicTimer>
 #include <QHash>
 #include <QObject>
+#include <QRegion>
+#include <QSet>
 
 namespace Breeze
 {
@@ -50,8 +53,41 @@ namespace Breeze
             object->installEventFilter( this );
         }
 
+        //! timer event, used to send pending blur regions
+        void timerEvent( QTimerEvent* ) override;
+
+        //! schedule update of blur regions for given widget
+        /*! used on resize. Updates are coalesced, and sent once per event loop pass */
+        void scheduleUpdate( QWidget* );
+
         //! update blur regions for given widget
-        void update( QWidget* ) const;
+        void update( QWidget* );
+
+        //! blur region for given widget, matching its rounded shape
+        QRegion blurRegion( QWidget* ) const;
+
+        protected Q_SLOTS:
+
+        //! remove widget from pending updates and sent regions
+        void widgetDestroyed( QObject* );
+
+        private:
+
+        //! region sent to the compositor, and window it was sent for
+        struct BlurState
+        {
+            WId winId = 0;
+            QRegion region;
+        };
+
+        //! sent blur regions, per widget
+        QHash<const QObject*, BlurState> _sentRegions;
+
+        //! widgets with pending update
+        QSet<QWidget*> _pendingWidgets;
+
+        //! timer used to coalesce updates
+        QBasicTimer _timer;
 
     };
 
@@ -93,6 +93,13 @@ namespace Breeze
                 break;
             }
 
+            // geometry is only updated when the frame is resized, never while painting
+            case QEvent::Resize:
+            {
+                updateShadowsGeometry( object );
+                break;
+            }
+
             default: break;
         }
 
@@ -109,8 +116,9 @@ namespace Breeze
         widget->installEventFilter(this);
 
         widget->installEventFilter( &_addEventFilter );
-        installShadow( widget, helper, SideTop );
-        installShadow( widget, helper, SideBottom );
+        auto shadow( new FrameShadow( helper ) );
+        shadow->setParent( widget );
+        shadow->updateShadowGeometry();
         widget->removeEventFilter( &_addEventFilter );
 
     }
@@ -135,64 +143,53 @@ namespace Breeze
     }
 
     //____________________________________________________________________________________
-    void FrameShadowFactory::updateShadowsGeometry( const QObject* object, QRect rect ) const
+    FrameShadow* FrameShadowFactory::findShadow( const QObject* object ) const
     {
 
         const QList<QObject *> &children = object->children();
         foreach( QObject *child, children )
         {
             if( FrameShadow* shadow = qobject_cast<FrameShadow *>(child) )
-            { shadow->updateGeometry( rect ); }
+            { return shadow; }
         }
 
+        return nullptr;
+
     }
 
     //____________________________________________________________________________________
-    void FrameShadowFactory::raiseShadows( QObject* object ) const
+    void FrameShadowFactory::updateShadowsGeometry( const QObject* object ) const
     {
-
-        const QList<QObject *> &children = object->children();
-        foreach( QObject *child, children )
-        {
-            if( FrameShadow* shadow = qobject_cast<FrameShadow *>(child) )
-            { shadow->raise(); }
-        }
-
+        if( FrameShadow* shadow = findShadow( object ) )
+        { shadow->updateShadowGeometry(); }
     }
 
     //____________________________________________________________________________________
-    void FrameShadowFactory::update( QObject* object ) const
+    void FrameShadowFactory::updateShadowsGeometry( const QObject* object, const QRect& rect ) const
     {
-
-        const QList<QObject* > &children = object->children();
-        foreach( QObject *child, children )
-        {
-            if( FrameShadow* shadow = qobject_cast<FrameShadow *>(child) )
-            { shadow->update();}
-        }
-
+        if( FrameShadow* shadow = findShadow( object ) )
+        { shadow->setFrameRect( rect ); }
     }
 
     //____________________________________________________________________________________
-    void FrameShadowFactory::updateState( const QWidget* widget, bool focus, bool hover, qreal opacity, AnimationMode mode ) const
+    void FrameShadowFactory::raiseShadows( QObject* object ) const
     {
+        if( FrameShadow* shadow = findShadow( object ) )
+        { shadow->raise(); }
+    }
 
-        const QList<QObject *> &children = widget->children();
-        foreach( QObject *child, children )
-        {
-            if( FrameShadow* shadow = qobject_cast<FrameShadow *>(child) )
-            { shadow->updateState( focus, hover, opacity, mode ); }
-        }
-
+    //____________________________________________________________________________________
+    void FrameShadowFactory::update( QObject* object ) const
+    {
+        if( FrameShadow* shadow = findShadow( object ) )
+        { shadow->update(); }
     }
 
     //____________________________________________________________________________________
-    void FrameShadowFactory::installShadow( QWidget* widget, Helper& helper, Side area ) const
+    void FrameShadowFactory::updateState( const QWidget* widget, bool focus, bool hover, qreal opacity, AnimationMode mode ) const
     {
-        FrameShadow *shadow(nullptr);
-        shadow = new FrameShadow( area, helper );
-        shadow->setParent(widget);
-        shadow->hide();
+        if( FrameShadow* shadow = findShadow( widget ) )
+        { shadow->updateState( focus, hover, opacity, mode ); }
     }
 
     //____________________________________________________________________________________
@@ -200,9 +197,8 @@ namespace Breeze
     { _registeredWidgets.remove( object ); }
 
     //____________________________________________________________________________________
-    FrameShadow::FrameShadow( Side area, Helper& helper ):
-        _helper( helper ),
-        _area( area )
+    FrameShadow::FrameShadow( Helper& helper ):
+        _helper( helper )
     {
 
         setAttribute(Qt::WA_OpaquePaintEvent, false);
@@ -220,52 +216,45 @@ namespace Breeze
     }
 
     //____________________________________________________________________________________
-    void FrameShadow::updateGeometry( QRect rect )
+    void FrameShadow::updateShadowGeometry()
     {
 
-        // show on first call
-        if( isHidden() ) show();
-
-        // store offsets between passed rect and parent widget rect
-        QRect parentRect( parentWidget()->contentsRect() );
-        _margins = QMargins(
-            rect.left() - parentRect.left(),
-            rect.top() - parentRect.top(),
-            rect.right() - parentRect.right(),
-            rect.bottom() - parentRect.bottom() );
+        _geometryUpdatePending = false;
+        if( !parentWidget() ) return;
 
         // for efficiency, take out the part for which nothing is rendered
-        rect.adjust( 1, 1, -1, -1 );
-
-        // adjust geometry
-        const int shadowSize( Metrics::Frame_FrameRadius );
-        switch( _area )
+        const QRect rect( parentFrameRect().adjusted( 1, 1, -1, -1 ) );
+        if( rect.isEmpty() )
         {
+            hide();
+            return;
+        }
 
-            case SideTop:
-            rect.setHeight( shadowSize );
-            break;
-
-            case SideBottom:
-            rect.setTop( rect.bottom() - shadowSize + 1 );
-            break;
+        // only the top and bottom bands, which contain the frame corners, are rendered
+        if( rect.size() != size() || mask().isEmpty() )
+        {
+            const int shadowSize( Metrics::Frame_FrameRadius );
+            QRegion mask( 0, 0, rect.width(), shadowSize );
+            mask += QRegion( 0, rect.height() - shadowSize, rect.width(), shadowSize );
+            setMask( mask );
+        }
 
-            case SideLeft:
-            rect.setWidth(shadowSize);
-            rect.adjust(0, shadowSize, 0, -shadowSize );
-            break;
+        setGeometry( rect );
+        if( isHidden() ) show();
 
+    }
 
-            case SideRight:
-            rect.setLeft(rect.right() - shadowSize + 1 );
-            rect.adjust(0, shadowSize, 0, -shadowSize );
-            break;
+    //____________________________________________________________________________________
+    void FrameShadow::setFrameRect( const QRect& rect )
+    {
 
-            default:
-            return;
-        }
+        if( rect == _frameRect ) return;
+        _frameRect = rect;
 
-        setGeometry(rect);
+        // never move or show widgets from within a paint event
+        if( _geometryUpdatePending ) return;
+        _geometryUpdatePending = true;
+        QMetaObject::invokeMethod( this, &FrameShadow::updateShadowGeometry, Qt::QueuedConnection );
 
     }
 
@@ -312,8 +301,7 @@ namespace Breeze
         if( QFrame *frame = qobject_cast<QFrame *>( parentWidget() ) )
         { if (frame->frameStyle() != (QFrame::StyledPanel | QFrame::Sunken)) return; }
 
-        const QRect parentRect( parentWidget()->contentsRect().translated( mapFromParent( QPoint( 0, 0 ) ) ) );
-        const QRect rect( parentRect.adjusted( _margins.left(), _margins.top(), _margins.right(), _margins.bottom() ) );
+        const QRect rect( parentFrameRect().translated( mapFromParent( QPoint( 0, 0 ) ) ) );
 
         // render
         QPainter painter(this);
@@ -326,6 +314,17 @@ namespace Breeze
 
     }
 
+    //____________________________________________________________________________________
+    QRect FrameShadow::parentFrameRect() const
+    {
+
+        // same rect as the one passed to the style when the frame is drawn
+        if( QFrame *frame = qobject_cast<QFrame *>( parentWidget() ) ) return frame->frameRect();
+        else if( _frameRect.isValid() ) return _frameRect;
+        else return parentWidget()->rect();
+
+    }
+
     //____________________________________________________________________________________
     QWidget* FrameShadow::viewport() const
     {
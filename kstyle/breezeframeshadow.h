@@ -22,6 +22,8 @@
 namespace Breeze
 {
 
+    class FrameShadow;
+
     //* shadow manager
     class FrameShadowFactory: public QObject
     {
@@ -51,8 +53,8 @@ namespace Breeze
         //* update state
         void updateState( const QWidget*, bool focus, bool hover, qreal opacity, AnimationMode ) const;
 
-        //* update shadows geometry
-        void updateShadowsGeometry( const QObject*, QRect ) const;
+        //* record frame rect, as passed to the style when the frame is drawn
+        void updateShadowsGeometry( const QObject*, const QRect& ) const;
 
         protected:
 
@@ -62,15 +64,18 @@ namespace Breeze
         //* remove shadows from widget
         void removeShadows( QWidget* );
 
+        //* find shadow installed on given widget
+        FrameShadow* findShadow( const QObject* ) const;
+
+        //* update shadows geometry
+        void updateShadowsGeometry( const QObject* ) const;
+
         //* raise shadows
         void raiseShadows( QObject* ) const;
 
         //* update shadows
         void update( QObject* ) const;
 
-        //* install shadow on given side
-        void installShadow( QWidget*, Helper&, Side ) const;
-
         protected Q_SLOTS:
 
         //* triggered by object destruction
@@ -87,7 +92,10 @@ namespace Breeze
     };
 
     //* frame shadow
-    /** this allows the shadow to be painted over the widgets viewport */
+    /**
+    this allows the shadow to be painted over the widgets viewport.
+    A single overlay covers the frame, masked to the top and bottom bands in which the frame corners are rendered
+    */
     class FrameShadow : public QWidget
     {
         Q_OBJECT
@@ -95,10 +103,17 @@ namespace Breeze
         public:
 
         //* constructor
-        FrameShadow( Side, Helper& );
+        explicit FrameShadow( Helper& );
 
-        //* update geometry
-        virtual void updateGeometry( QRect );
+        //* update geometry, from parent frame rect
+        void updateShadowGeometry();
+
+        //* set frame rect, in parent coordinates
+        /**
+        needed for widgets that are not QFrames, such as KTextEditor::View, whose frame rect
+        does not follow their size. Geometry is updated later on, since this is called while painting
+        */
+        void setFrameRect( const QRect& );
 
         //* update state
         void updateState( bool focus, bool hover, qreal opacity, AnimationMode );
@@ -111,17 +126,19 @@ namespace Breeze
         //* return viewport associated to parent widget
         QWidget* viewport() const;
 
+        //* frame rect of parent widget, in parent coordinates
+        QRect parentFrameRect() const;
+
         private:
 
         //* helper
         Helper& _helper;
 
-        //* shadow area
-        Side _area;
+        //* frame rect recorded while painting, if any
+        QRect _frameRect;
 
-        //* margins
-        /** offsets between update rect and parent widget rect. It is set via updateGeometry */
-        QMargins _margins;
+        //* true if a geometry update is scheduled
+        bool _geometryUpdatePending = false;
 
         //*@name widget state
         //@{
@@ -57,6 +57,10 @@ namespace Breeze
                 }
             });
         }
+
+        // compositing state is cached and kept in sync with the window manager
+        _compositingActive = queryCompositingActive();
+        connect( KWindowSystem::self(), &KWindowSystem::compositingChanged, this, [this]( bool active ) { _compositingActive = active; } );
     }
 
     //____________________________________________________________________
@@ -1596,7 +1600,7 @@ namespace Breeze
     }
 
     //________________________________________________________________________________________________________
-    bool Helper::compositingActive() const
+    bool Helper::queryCompositingActive() const
     {
 
         #if BREEZE_HAVE_QTX11EXTRAS
@@ -1609,6 +1613,10 @@ namespace Breeze
 
     }
 
+    //________________________________________________________________________________________________________
+    bool Helper::compositingActive() const
+    { return _compositingActive; }
+
     //____________________________________________________________________
     bool Helper::hasAlphaChannel( const QWidget* widget ) const
     { return compositingActive() && widget && widget->testAttribute( Qt::WA_TranslucentBackground ); }
@@ -266,6 +266,7 @@ namespace Breeze
         static bool isWayland();
 
         //* returns true if compositing is active
+        /** the value is cached, and updated whenever the window manager reports a change */
         bool compositingActive() const;
 
         //* returns true if a given widget supports alpha channel
@@ -303,6 +304,9 @@ namespace Breeze
 
         private:
 
+        //* query compositing state from the windowing system
+        bool queryCompositingActive() const;
+
         //* configuration
         KSharedConfig::Ptr _config;
 
@@ -332,6 +336,9 @@ namespace Breeze
 
         mutable bool _cachedAutoValid = false;
 
+        //* cached compositing state
+        bool _compositingActive = false;
+
         friend class ToolsAreaManager;
 
     };
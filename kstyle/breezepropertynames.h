@@ -18,8 +18,6 @@ namespace Breeze
         static const char netWMSkipShadow[];
         static const char sidePanelView[];
         static const char toolButtonAlignment[];
-        static const char menuTitle[];
-        static const char alteredBackground[];
         static const char highlightNeutral[];
         static const char noSeparator[];
     };
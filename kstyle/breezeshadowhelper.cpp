@@ -12,6 +12,7 @@
 #include "breezehelper.h"
 #include "breezepropertynames.h"
 #include "breezestyleconfigdata.h"
+#include "breezewidgettraits.h"
 
 #include <QDockWidget>
 #include <QEvent>
@@ -280,19 +281,19 @@ namespace Breeze
 
     //_______________________________________________________
     bool ShadowHelper::isMenu( QWidget* widget ) const
-    { return qobject_cast<QMenu*>( widget ); }
+    { return WidgetTraits::get( widget ).is( WidgetTraits::Menu ); }
 
     //_______________________________________________________
     bool ShadowHelper::isToolTip( QWidget* widget ) const
-    { return widget->inherits( "QTipLabel" ) || (widget->windowFlags() & Qt::WindowType_Mask) == Qt::ToolTip; }
+    { return WidgetTraits::get( widget ).is( WidgetTraits::ToolTipLabel ) || (widget->windowFlags() & Qt::WindowType_Mask) == Qt::ToolTip; }
 
     //_______________________________________________________
     bool ShadowHelper::isDockWidget( QWidget* widget ) const
-    { return qobject_cast<QDockWidget*>( widget ); }
+    { return WidgetTraits::get( widget ).is( WidgetTraits::DockWidget ); }
 
     //_______________________________________________________
     bool ShadowHelper::isToolBar( QWidget* widget ) const
-    { return qobject_cast<QToolBar*>( widget ); }
+    { return WidgetTraits::get( widget ).is( WidgetTraits::ToolBar ); }
 
     //_______________________________________________________
     bool ShadowHelper::acceptWidget( QWidget* widget ) const
@@ -302,19 +303,18 @@ namespace Breeze
         if( widget->property( PropertyNames::netWMSkipShadow ).toBool() ) return false;
         if( widget->property( PropertyNames::netWMForceShadow ).toBool() ) return true;
 
-        // menus
-        if( isMenu( widget ) ) return true;
-
-        // combobox dropdown lists
-        if( widget->inherits( "QComboBoxPrivateContainer" ) ) return true;
-
-        // tooltips
-        if( isToolTip( widget ) && !widget->inherits( "Plasma::ToolTip" ) )
-        { return true; }
-
-        // detached widgets
-        if( isDockWidget( widget ) || isToolBar( widget ) )
-        { return true; }
+        // class-wide shadow policy
+        switch( WidgetTraits::get( widget ).shadowPolicy )
+        {
+            // menus, combobox dropdown lists, tooltips and detached widgets
+            case WidgetTraits::ShadowAccept: return true;
+            case WidgetTraits::ShadowReject: return false;
+
+            // other tooltips
+            case WidgetTraits::ShadowIfToolTip:
+            if( isToolTip( widget ) ) return true;
+            break;
+        }
 
         // reject
         return false;
@@ -328,14 +328,14 @@ namespace Breeze
         if( _tiles.isEmpty() )
         {
             _tiles = {
-                createTile( _shadowTiles.pixmap( 1 ) ),
-                createTile( _shadowTiles.pixmap( 2 ) ),
-                createTile( _shadowTiles.pixmap( 5 ) ),
-                createTile( _shadowTiles.pixmap( 8 ) ),
-                createTile( _shadowTiles.pixmap( 7 ) ),
-                createTile( _shadowTiles.pixmap( 6 ) ),
-                createTile( _shadowTiles.pixmap( 3 ) ),
-                createTile( _shadowTiles.pixmap( 0 ) )
+                createTile( _shadowTiles.image( 1 ) ),
+                createTile( _shadowTiles.image( 2 ) ),
+                createTile( _shadowTiles.image( 5 ) ),
+                createTile( _shadowTiles.image( 8 ) ),
+                createTile( _shadowTiles.image( 7 ) ),
+                createTile( _shadowTiles.image( 6 ) ),
+                createTile( _shadowTiles.image( 3 ) ),
+                createTile( _shadowTiles.image( 0 ) )
             };
         }
 
@@ -345,11 +345,11 @@ namespace Breeze
     }
 
     //______________________________________________
-    KWindowShadowTile::Ptr ShadowHelper::createTile( const QPixmap& source )
+    KWindowShadowTile::Ptr ShadowHelper::createTile( const QImage& source )
     {
 
         KWindowShadowTile::Ptr tile = KWindowShadowTile::Ptr::create();
-        tile->setImage( source.toImage() );
+        tile->setImage( source );
         return tile;
 
     }
@@ -446,7 +446,7 @@ namespace Breeze
             }
         }
 
-        margins *= _helper.devicePixelRatio(_shadowTiles.pixmap(0));
+        margins *= _shadowTiles.devicePixelRatio();
 
         return margins;
     }
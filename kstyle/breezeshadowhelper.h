@@ -123,8 +123,8 @@ namespace Breeze
         // create shared shadow tiles from tileset
         const QVector<KWindowShadowTile::Ptr>& createShadowTiles();
 
-        // create shadow tile from pixmap
-        KWindowShadowTile::Ptr createTile( const QPixmap& );
+        // create shadow tile from tileset image
+        KWindowShadowTile::Ptr createTile( const QImage& );
 
         //* installs shadow on given widget in a platform independent way
         void installShadows( QWidget * );
@@ -18,6 +18,8 @@
 #include "breezewindowmanager.h"
 #include "breezeblurhelper.h"
 #include "breezetoolsareamanager.h"
+#include "breezewidgetflagcache.h"
+#include "breezewidgettraits.h"
 
 #include <KColorUtils>
 #include <KIconLoader>
@@ -194,6 +196,7 @@ namespace Breeze
         , _mdiWindowShadowFactory( new MdiWindowShadowFactory( this ) )
         , _splitterFactory( new SplitterFactory( this ) )
         , _toolsAreaManager ( new ToolsAreaManager( _helper, this ) )
+        , _widgetFlagCache( new WidgetFlagCache( this ) )
         , _widgetExplorer( new WidgetExplorer( this ) )
         , _tabBarData( new BreezePrivate::TabBarData( this ) )
         #if BREEZE_HAVE_KSTYLE
@@ -252,24 +255,11 @@ namespace Breeze
         _splitterFactory->registerWidget( widget );
         _toolsAreaManager->registerWidget ( widget );
 
+        // class-wide traits
+        const auto traits( WidgetTraits::get( widget ) );
+
         // enable mouse over effects for all necessary widgets
-        if(
-            qobject_cast<QAbstractItemView*>( widget )
-            || qobject_cast<QAbstractSpinBox*>( widget )
-            || qobject_cast<QCheckBox*>( widget )
-            || qobject_cast<QComboBox*>( widget )
-            || qobject_cast<QDial*>( widget )
-            || qobject_cast<QLineEdit*>( widget )
-            || qobject_cast<QPushButton*>( widget )
-            || qobject_cast<QRadioButton*>( widget )
-            || qobject_cast<QScrollBar*>( widget )
-            || qobject_cast<QSlider*>( widget )
-            || qobject_cast<QSplitterHandle*>( widget )
-            || qobject_cast<QTabBar*>( widget )
-            || qobject_cast<QTextEdit*>( widget )
-            || qobject_cast<QToolButton*>( widget )
-            || widget->inherits( "KTextEditor::View" )
-            )
+        if( traits.hover )
         { widget->setAttribute( Qt::WA_Hover ); }
 
         // enforce translucency for drag and drop window
@@ -280,29 +270,35 @@ namespace Breeze
         }
 
         // scrollarea polishing is somewhat complex. It is moved to a dedicated method
-        polishScrollArea( qobject_cast<QAbstractScrollArea*>( widget ) );
+        if( traits.is( WidgetTraits::ScrollArea ) )
+        { polishScrollArea( static_cast<QAbstractScrollArea*>( widget ) ); }
 
-        if( auto itemView = qobject_cast<QAbstractItemView*>( widget ) )
+        // scrollbars may be nested anywhere below a text editor view
+        if( traits.is( WidgetTraits::ScrollBar ) )
+        { invalidateScrollAreaChildren( widget ); }
+
+        const auto parentTraits( WidgetTraits::get( widget->parent() ) );
+        if( traits.is( WidgetTraits::ItemView ) )
         {
 
             // enable mouse over effects in itemviews' viewport
-            itemView->viewport()->setAttribute( Qt::WA_Hover );
+            static_cast<QAbstractItemView*>( widget )->viewport()->setAttribute( Qt::WA_Hover );
 
-        } else if( auto groupBox = qobject_cast<QGroupBox*>( widget ) )  {
+        } else if( traits.is( WidgetTraits::GroupBox ) )  {
 
             // checkable group boxes
-            if( groupBox->isCheckable() )
-            { groupBox->setAttribute( Qt::WA_Hover ); }
+            if( static_cast<QGroupBox*>( widget )->isCheckable() )
+            { widget->setAttribute( Qt::WA_Hover ); }
 
-        } else if( qobject_cast<QAbstractButton*>( widget ) && qobject_cast<QDockWidget*>( widget->parent() ) ) {
+        } else if( traits.is( WidgetTraits::AbstractButton ) && parentTraits.is( WidgetTraits::DockWidget ) ) {
 
             widget->setAttribute( Qt::WA_Hover );
 
-        } else if( qobject_cast<QAbstractButton*>( widget ) && qobject_cast<QToolBox*>( widget->parent() ) ) {
+        } else if( traits.is( WidgetTraits::AbstractButton ) && parentTraits.is( WidgetTraits::ToolBox ) ) {
 
             widget->setAttribute( Qt::WA_Hover );
 
-        } else if( qobject_cast<QFrame*>( widget ) && widget->parent() && widget->parent()->inherits( "KTitleWidget" ) ) {
+        } else if( traits.is( WidgetTraits::Frame ) && parentTraits.is( WidgetTraits::TitleWidget ) ) {
 
             widget->setAutoFillBackground( false );
             if( !StyleConfigData::titleWidgetDrawFrame() )
@@ -310,19 +306,19 @@ namespace Breeze
 
         }
 
-        if( qobject_cast<QScrollBar*>( widget ) )
+        if( traits.is( WidgetTraits::ScrollBar ) )
         {
 
             // remove opaque painting for scrollbars
             widget->setAttribute( Qt::WA_OpaquePaintEvent, false );
 
-        } else if( widget->inherits( "KTextEditor::View" ) ) {
+        } else if( traits.is( WidgetTraits::TextEditorView ) ) {
 
             addEventFilter( widget );
 
-        } else if( auto toolButton = qobject_cast<QToolButton*>( widget ) ) {
+        } else if( traits.is( WidgetTraits::ToolButton ) ) {
 
-            if( toolButton->autoRaise() )
+            if( static_cast<QToolButton*>( widget )->autoRaise() )
             {
                 // for flat toolbuttons, adjust foreground and background role accordingly
                 widget->setBackgroundRole( QPalette::NoRole );
@@ -334,7 +330,7 @@ namespace Breeze
                 widget->parentWidget()->parentWidget()->inherits( "Gwenview::SideBarGroup" ) )
             { widget->setProperty( PropertyNames::toolButtonAlignment, Qt::AlignLeft ); }
 
-        } else if( qobject_cast<QDockWidget*>( widget ) ) {
+        } else if( traits.is( WidgetTraits::DockWidget ) ) {
 
             // add event filter on dock widgets
             // and alter palette
@@ -342,23 +338,23 @@ namespace Breeze
             widget->setContentsMargins( Metrics::Frame_FrameWidth, Metrics::Frame_FrameWidth, Metrics::Frame_FrameWidth, Metrics::Frame_FrameWidth );
             addEventFilter( widget );
 
-        } else if( qobject_cast<QMdiSubWindow*>( widget ) ) {
+        } else if( traits.is( WidgetTraits::MdiSubWindow ) ) {
 
             widget->setAutoFillBackground( false );
             addEventFilter( widget );
 
-        } else if( qobject_cast<QToolBox*>( widget ) ) {
+        } else if( traits.is( WidgetTraits::ToolBox ) ) {
 
             widget->setBackgroundRole( QPalette::NoRole );
             widget->setAutoFillBackground( false );
 
-        } else if( widget->parentWidget() && widget->parentWidget()->parentWidget() && qobject_cast<QToolBox*>( widget->parentWidget()->parentWidget()->parentWidget() ) ) {
+        } else if( widget->parentWidget() && widget->parentWidget()->parentWidget() && WidgetTraits::get( widget->parentWidget()->parentWidget()->parentWidget() ).is( WidgetTraits::ToolBox ) ) {
 
             widget->setBackgroundRole( QPalette::NoRole );
             widget->setAutoFillBackground( false );
             widget->parentWidget()->setAutoFillBackground( false );
 
-        } else if( qobject_cast<QMenu*>( widget ) ) {
+        } else if( traits.is( WidgetTraits::Menu ) ) {
 
             setTranslucentBackground( widget );
 
@@ -366,32 +362,32 @@ namespace Breeze
                 _blurHelper->registerWidget( widget->window() );
             }
 
-        } else if( qobject_cast<QCommandLinkButton*>( widget ) ) {
+        } else if( traits.is( WidgetTraits::CommandLinkButton ) ) {
 
             addEventFilter( widget );
 
-        } else if( auto comboBox = qobject_cast<QComboBox*>( widget ) ) {
+        } else if( traits.is( WidgetTraits::ComboBox ) ) {
 
             if( !hasParent( widget, "QWebView" ) )
             {
-                auto itemView( comboBox->view() );
+                auto itemView( static_cast<QComboBox*>( widget )->view() );
                 if( itemView && itemView->itemDelegate() && itemView->itemDelegate()->inherits( "QComboBoxDelegate" ) )
                 { itemView->setItemDelegate( new BreezePrivate::ComboBoxItemDelegate( itemView ) ); }
             }
 
-        } else if( widget->inherits( "QComboBoxPrivateContainer" ) ) {
+        } else if( traits.is( WidgetTraits::ComboBoxContainer ) ) {
 
             addEventFilter( widget );
             setTranslucentBackground( widget );
 
-        } else if( widget->inherits( "QTipLabel" ) ) {
+        } else if( traits.is( WidgetTraits::ToolTipLabel ) ) {
 
             setTranslucentBackground( widget );
 
-        } else if ( qobject_cast<QMainWindow*> (widget) ) {
+        } else if ( traits.is( WidgetTraits::MainWindow ) ) {
             widget->setAttribute(Qt::WA_StyledBackground);
         }
-        else if ( qobject_cast<QDialog*> (widget) ) {
+        else if ( traits.is( WidgetTraits::Dialog ) ) {
             widget->setAttribute(Qt::WA_StyledBackground);
         }
 
@@ -407,6 +403,16 @@ namespace Breeze
         _toolsAreaManager->registerApplication(application);
     }
 
+    //______________________________________________________________
+    void Style::unpolish( QApplication *application )
+    {
+        // drop cached traits, which point to metaobjects of possibly unloaded plugins
+        WidgetTraits::clearCache();
+        _widgetFlagCache->clear();
+
+        ParentStyleClass::unpolish( application );
+    }
+
     //______________________________________________________________
     void Style::polishScrollArea( QAbstractScrollArea* scrollArea )
     {
@@ -490,13 +496,16 @@ namespace Breeze
         _splitterFactory->unregisterWidget( widget );
         _blurHelper->unregisterWidget( widget );
         _toolsAreaManager->unregisterWidget ( widget );
+        _widgetFlagCache->remove( widget );
+
+        // drop or invalidate cached scrollarea children
+        _scrollAreaChildren.remove( widget );
+        if( WidgetTraits::get( widget ).is( WidgetTraits::ScrollBar ) )
+        { invalidateScrollAreaChildren( widget ); }
 
         // remove event filter
-        if( qobject_cast<QAbstractScrollArea*>( widget ) ||
-            qobject_cast<QDockWidget*>( widget ) ||
-            qobject_cast<QMdiSubWindow*>( widget ) ||
-            widget->inherits( "QComboBoxPrivateContainer" ) )
-            { widget->removeEventFilter( this ); }
+        if( WidgetTraits::get( widget ).is( WidgetTraits::ScrollArea|WidgetTraits::DockWidget|WidgetTraits::MdiSubWindow|WidgetTraits::ComboBoxContainer ) )
+        { widget->removeEventFilter( this ); }
 
         ParentStyleClass::unpolish( widget );
 
@@ -1093,16 +1102,17 @@ namespace Breeze
     bool Style::eventFilter( QObject *object, QEvent *event )
     {
 
-        if( auto dockWidget = qobject_cast<QDockWidget*>( object ) ) { return eventFilterDockWidget( dockWidget, event ); }
-        else if( auto subWindow = qobject_cast<QMdiSubWindow*>( object ) ) { return eventFilterMdiSubWindow( subWindow, event ); }
-        else if( auto commandLinkButton = qobject_cast<QCommandLinkButton*>( object ) ) { return eventFilterCommandLinkButton( commandLinkButton, event ); }
+        const auto traits( WidgetTraits::get( object ) );
+        if( traits.is( WidgetTraits::DockWidget ) ) { return eventFilterDockWidget( static_cast<QDockWidget*>( object ), event ); }
+        else if( traits.is( WidgetTraits::MdiSubWindow ) ) { return eventFilterMdiSubWindow( static_cast<QMdiSubWindow*>( object ), event ); }
+        else if( traits.is( WidgetTraits::CommandLinkButton ) ) { return eventFilterCommandLinkButton( static_cast<QCommandLinkButton*>( object ), event ); }
         #if QT_VERSION < 0x050D00 // Check if Qt version < 5.13
         else if( object == qApp && event->type() == QEvent::ApplicationPaletteChange ) { configurationChanged(); }
         #endif
         // cast to QWidget
         QWidget *widget = static_cast<QWidget*>( object );
-        if( widget->inherits( "QAbstractScrollArea" ) || widget->inherits( "KTextEditor::View" ) ) { return eventFilterScrollArea( widget, event ); }
-        else if( widget->inherits( "QComboBoxPrivateContainer" ) ) { return eventFilterComboBoxContainer( widget, event ); }
+        if( traits.is( WidgetTraits::ScrollArea|WidgetTraits::TextEditorView ) ) { return eventFilterScrollArea( widget, event ); }
+        else if( traits.is( WidgetTraits::ComboBoxContainer ) ) { return eventFilterComboBoxContainer( widget, event ); }
 
         // fallback
         return ParentStyleClass::eventFilter( object, event );
@@ -1124,16 +1134,17 @@ namespace Breeze
                 if( !( scrollArea && (viewport = scrollArea->viewport()) ) ) break;
 
                 // get scrollarea horizontal and vertical containers
-                QWidget* child( nullptr );
+                const auto scrollAreaChildren( this->scrollAreaChildren( widget ) );
+                if( scrollAreaChildren.hasStyleSheet ) break;
+
                 QList<QWidget*> children;
-                if( ( child = scrollArea->findChild<QWidget*>( "qt_scrollarea_vcontainer" ) ) && child->isVisible() )
-                { children.append( child ); }
+                if( scrollAreaChildren.vContainer && scrollAreaChildren.vContainer.data()->isVisible() )
+                { children.append( scrollAreaChildren.vContainer.data() ); }
 
-                if( ( child = scrollArea->findChild<QWidget*>( "qt_scrollarea_hcontainer" ) ) && child->isVisible() )
-                { children.append( child ); }
+                if( scrollAreaChildren.hContainer && scrollAreaChildren.hContainer.data()->isVisible() )
+                { children.append( scrollAreaChildren.hContainer.data() ); }
 
                 if( children.empty() ) break;
-                if( !scrollArea->styleSheet().isEmpty() ) break;
 
                 // make sure proper background is rendered behind the containers
                 QPainter painter( scrollArea );
@@ -1174,9 +1185,10 @@ namespace Breeze
                     if( scrollArea->horizontalScrollBarPolicy() != Qt::ScrollBarAlwaysOff ) scrollBars.append( scrollArea->horizontalScrollBar() );
                     if( scrollArea->verticalScrollBarPolicy() != Qt::ScrollBarAlwaysOff )scrollBars.append( scrollArea->verticalScrollBar() );
 
-                } else if( widget->inherits( "KTextEditor::View" ) ) {
+                } else {
 
-                    scrollBars = widget->findChildren<QScrollBar*>();
+                    foreach( const auto& scrollBar, scrollAreaChildren( widget ).scrollBars )
+                    { if( scrollBar ) scrollBars.append( scrollBar.data() ); }
 
                 }
 
@@ -1213,6 +1225,16 @@ namespace Breeze
 
             }
 
+            case QEvent::ChildAdded:
+            case QEvent::ChildRemoved:
+            case QEvent::StyleChange:
+            {
+                // helper children must be resolved again
+                auto iter = _scrollAreaChildren.find( widget );
+                if( iter != _scrollAreaChildren.end() ) iter->valid = false;
+                break;
+            }
+
             default: break;
 
         }
@@ -1221,6 +1243,58 @@ namespace Breeze
 
     }
 
+    //____________________________________________________________________________
+    Style::ScrollAreaChildren Style::scrollAreaChildren( QWidget* widget )
+    {
+
+        auto iter = _scrollAreaChildren.find( widget );
+        if( iter == _scrollAreaChildren.end() )
+        {
+            // make sure entry is removed with the widget
+            connect( widget, &QObject::destroyed, this, &Style::scrollAreaDestroyed, Qt::UniqueConnection );
+            iter = _scrollAreaChildren.insert( widget, ScrollAreaChildren() );
+        }
+
+        auto& children( iter.value() );
+        if( !children.valid )
+        {
+
+            children.valid = true;
+            children.hasStyleSheet = !widget->styleSheet().isEmpty();
+
+            if( WidgetTraits::get( widget ).is( WidgetTraits::ScrollArea ) )
+            {
+
+                children.vContainer = widget->findChild<QWidget*>( QStringLiteral( "qt_scrollarea_vcontainer" ) );
+                children.hContainer = widget->findChild<QWidget*>( QStringLiteral( "qt_scrollarea_hcontainer" ) );
+
+            } else {
+
+                children.scrollBars.clear();
+                foreach( auto scrollBar, widget->findChildren<QScrollBar*>() )
+                { children.scrollBars.append( scrollBar ); }
+
+            }
+
+        }
+
+        return children;
+
+    }
+
+    //____________________________________________________________________________
+    void Style::invalidateScrollAreaChildren( const QWidget* widget )
+    {
+
+        if( _scrollAreaChildren.isEmpty() ) return;
+        for( auto parent = widget->parentWidget(); parent; parent = parent->parentWidget() )
+        {
+            auto iter = _scrollAreaChildren.find( parent );
+            if( iter != _scrollAreaChildren.end() ) iter->valid = false;
+        }
+
+    }
+
     //_________________________________________________________
     bool Style::eventFilterComboBoxContainer( QWidget* widget, QEvent* event )
     {
@@ -1539,6 +1613,9 @@ namespace Breeze
         // clear icon cache
         _iconCache.clear();
 
+        // cached widget flags may depend on configuration
+        _widgetFlagCache->clear();
+
         // scrollbar buttons
         switch( StyleConfigData::scrollBarAddLineButtons() )
         {
@@ -3103,8 +3180,7 @@ namespace Breeze
         const bool isTitleWidget(
             StyleConfigData::titleWidgetDrawFrame() &&
             widget &&
-            widget->parent() &&
-            widget->parent()->inherits( "KTitleWidget" ) );
+            WidgetTraits::get( widget->parent() ).is( WidgetTraits::TitleWidget ) );
 
         // copy state
         const State& state( option->state );
@@ -3139,7 +3215,7 @@ namespace Breeze
             if( _frameShadowFactory->isRegistered( widget ) )
             {
 
-                // update frame shadow factory
+                // update frame shadow state and rect. Geometry is updated on resize, or when the rect changes
                 _frameShadowFactory->updateShadowsGeometry( widget, rect );
                 _frameShadowFactory->updateState( widget, hasFocus, mouseOver, opacity, mode );
 
@@ -7292,25 +7368,25 @@ namespace Breeze
         // check widget
         if( !widget ) return false;
 
-        // check property
-        const QVariant property( widget->property( PropertyNames::menuTitle ) );
-        if( property.isValid() ) return property.toBool();
+        // check cache
+        bool isMenuTitle( false );
+        if( _widgetFlagCache->find( widget, WidgetFlagCache::MenuTitle, isMenuTitle ) ) return isMenuTitle;
 
         // detect menu toolbuttons
         QWidget* parent = widget->parentWidget();
-        if( qobject_cast<QMenu*>( parent ) )
+        if( WidgetTraits::get( parent ).is( WidgetTraits::Menu ) )
         {
             foreach( auto child, parent->findChildren<QWidgetAction*>() )
             {
                 if( child->defaultWidget() != widget ) continue;
-                const_cast<QWidget*>(widget)->setProperty( PropertyNames::menuTitle, true );
-                return true;
+                isMenuTitle = true;
+                break;
             }
 
         }
 
-        const_cast<QWidget*>(widget)->setProperty( PropertyNames::menuTitle, false );
-        return false;
+        _widgetFlagCache->insert( widget, WidgetFlagCache::MenuTitle, isMenuTitle );
+        return isMenuTitle;
 
     }
 
@@ -7321,19 +7397,19 @@ namespace Breeze
         // check widget
         if( !widget ) return false;
 
-        // check property
-        const QVariant property( widget->property( PropertyNames::alteredBackground ) );
-        if( property.isValid() ) return property.toBool();
+        // check cache
+        bool hasAlteredBackground( false );
+        if( _widgetFlagCache->find( widget, WidgetFlagCache::AlteredBackground, hasAlteredBackground ) ) return hasAlteredBackground;
 
         // check if widget is of relevant type
-        bool hasAlteredBackground( false );
-        if( const auto groupBox = qobject_cast<const QGroupBox*>( widget ) ) hasAlteredBackground = !groupBox->isFlat();
+        const auto traits( WidgetTraits::get( widget ) );
+        if( traits.is( WidgetTraits::GroupBox ) ) hasAlteredBackground = !static_cast<const QGroupBox*>( widget )->isFlat();
         else if( const auto tabWidget = qobject_cast<const QTabWidget*>( widget ) ) hasAlteredBackground = !tabWidget->documentMode();
-        else if( qobject_cast<const QMenu*>( widget ) ) hasAlteredBackground = true;
-        else if( StyleConfigData::dockWidgetDrawFrame() && qobject_cast<const QDockWidget*>( widget ) ) hasAlteredBackground = true;
+        else if( traits.is( WidgetTraits::Menu ) ) hasAlteredBackground = true;
+        else if( StyleConfigData::dockWidgetDrawFrame() && traits.is( WidgetTraits::DockWidget ) ) hasAlteredBackground = true;
 
         if( widget->parentWidget() && !hasAlteredBackground ) hasAlteredBackground = this->hasAlteredBackground( widget->parentWidget() );
-        const_cast<QWidget*>(widget)->setProperty( PropertyNames::alteredBackground, hasAlteredBackground );
+        _widgetFlagCache->insert( widget, WidgetFlagCache::AlteredBackground, hasAlteredBackground );
         return hasAlteredBackground;
 
     }
@@ -7353,11 +7429,14 @@ namespace Breeze
             styleObject = option->styleObject;
         }
 
-        const QVariant property( styleObject->property( PropertyNames::highlightNeutral ) );
-        if ( property.isValid() ) {
-            return property.toBool();
+        bool highlightNeutral( false );
+        if( _widgetFlagCache->find( styleObject, WidgetFlagCache::HighlightNeutral, highlightNeutral ) ) {
+            return highlightNeutral;
         }
-        return false;
+
+        highlightNeutral = styleObject->property( PropertyNames::highlightNeutral ).toBool();
+        _widgetFlagCache->insert( styleObject, WidgetFlagCache::HighlightNeutral, highlightNeutral );
+        return highlightNeutral;
     }
 
 }
@@ -25,6 +25,7 @@
 #include <QHash>
 #include <QIcon>
 #include <QMdiSubWindow>
+#include <QScrollBar>
 #include <QStyleOption>
 #include <QWidget>
 
@@ -49,6 +50,7 @@ namespace Breeze
     class WindowManager;
     class BlurHelper;
     class ToolsAreaManager;
+    class WidgetFlagCache;
 
     //* convenience typedef for base class
     #if !BREEZE_HAVE_KSTYLE
@@ -87,6 +89,9 @@ namespace Breeze
         //* application polishing
         void polish( QApplication* ) override;
 
+        //* application unpolishing
+        void unpolish( QApplication* ) override;
+
         //* polish scrollarea
         void polishScrollArea( QAbstractScrollArea* );
 
@@ -153,6 +158,10 @@ namespace Breeze
         //* standard icons
         QIcon standardIconImplementation( StandardPixmap, const QStyleOption*, const QWidget* ) const;
 
+        //* remove scrollarea helper children of a destroyed scrollarea
+        void scrollAreaDestroyed( QObject* object )
+        { _scrollAreaChildren.remove( object ); }
+
         protected:
 
         //* standard icons
@@ -161,9 +170,37 @@ namespace Breeze
 
         private:
 
+        //* scrollarea helper children
+        /**
+        resolved once, and invalidated on ChildAdded, ChildRemoved and StyleChange events.
+        Since KTextEditor::View scrollbars are not direct children, entries are also invalidated
+        whenever a scrollbar is polished or unpolished inside the scrollarea
+        */
+        struct ScrollAreaChildren
+        {
+            //* true if children need not be resolved again
+            bool valid = false;
+
+            //* true if the scrollarea has a style sheet
+            bool hasStyleSheet = false;
+
+            //* scrollbar containers (QAbstractScrollArea)
+            WeakPointer<QWidget> vContainer;
+            WeakPointer<QWidget> hContainer;
+
+            //* scrollbars (KTextEditor::View)
+            QList<WeakPointer<QScrollBar>> scrollBars;
+        };
+
         //* load configuration
         void loadConfiguration();
 
+        //* resolve scrollarea helper children, using cached values when valid
+        ScrollAreaChildren scrollAreaChildren( QWidget* );
+
+        //* invalidate cached helper children of all scrollareas containing a given widget
+        void invalidateScrollAreaChildren( const QWidget* );
+
         //*@name subelementRect specialized functions
         //@{
 
@@ -504,6 +541,9 @@ namespace Breeze
         //* signal manager for the tools area
         ToolsAreaManager* _toolsAreaManager = nullptr;
 
+        //* per-widget style flags
+        WidgetFlagCache* _widgetFlagCache = nullptr;
+
         //* widget explorer
         WidgetExplorer* _widgetExplorer = nullptr;
 
@@ -514,6 +554,9 @@ namespace Breeze
         using IconCache = QHash<StandardPixmap, QIcon>;
         IconCache _iconCache;
 
+        //* scrollarea helper children, by scrollarea
+        QHash<const QObject*, ScrollAreaChildren> _scrollAreaChildren;
+
         //* pointer to primitive specialized function
         using StylePrimitive = std::function<bool(const Style&, const QStyleOption*, QPainter*, const QWidget*)>;
         StylePrimitive _frameFocusPrimitive;
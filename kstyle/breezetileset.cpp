@@ -8,6 +8,8 @@
 
 #include <QPainter>
 
+#include <cstring>
+
 namespace Breeze
 {
 
@@ -15,96 +17,122 @@ namespace Breeze
     inline bool bits(TileSet::Tiles flags, TileSet::Tiles testFlags)
     { return (flags & testFlags) == testFlags; }
 
-    //______________________________________________________________________________________
-    inline qreal devicePixelRatio( const QPixmap& pixmap )
-    {
-        return pixmap.devicePixelRatio();
-    }
-
-    //______________________________________________________________________________________
-    inline void setDevicePixelRatio( QPixmap& pixmap, qreal value )
-    {
-        return pixmap.setDevicePixelRatio( value );
-    }
-
-    //______________________________________________________________
-    void TileSet::initPixmap( PixmapList& pixmaps, const QPixmap &source, int width, int height, const QRect &rect)
-    {
-        QSize size( width, height );
-        if( !( size.isValid() && rect.isValid() ) )
-        {
-            pixmaps.append( QPixmap() );
-
-        } else if( size != rect.size() ) {
-
-            const qreal dpiRatio( devicePixelRatio( source ) );
-            const QRect scaledRect( rect.topLeft()*dpiRatio, rect.size()*dpiRatio );
-            const QSize scaledSize( size*dpiRatio );
-            const QPixmap tile( source.copy(scaledRect) );
-            QPixmap pixmap( scaledSize );
-
-            pixmap.fill(Qt::transparent);
-            QPainter painter(&pixmap);
-            painter.drawTiledPixmap(0, 0, scaledSize.width(), scaledSize.height(), tile);
-            setDevicePixelRatio( pixmap, dpiRatio );
-            pixmaps.append( pixmap );
-
-        } else {
-
-            const qreal dpiRatio( devicePixelRatio( source ) );
-            const QRect scaledRect( rect.topLeft()*dpiRatio, rect.size()*dpiRatio );
-            QPixmap pixmap( source.copy( scaledRect ) );
-            setDevicePixelRatio( pixmap, dpiRatio );
-            pixmaps.append( pixmap );
-
-        }
-
-    }
-
     //______________________________________________________________
     TileSet::TileSet():
         _w1(0),
         _h1(0),
+        _w2(0),
+        _h2(0),
         _w3(0),
         _h3(0)
-    { _pixmaps.reserve(9); }
+    {}
 
     //______________________________________________________________
     TileSet::TileSet(const QPixmap &source, int w1, int h1, int w2, int h2 ):
         _w1(w1),
         _h1(h1),
+        _w2(w2),
+        _h2(h2),
         _w3(0),
         _h3(0)
     {
-        _pixmaps.reserve(9);
         if( source.isNull() ) return;
 
-        _w3 = source.width()/devicePixelRatio( source ) - (w1 + w2);
-        _h3 = source.height()/devicePixelRatio( source ) - (h1 + h2);
-        int w = w2;
-        int h = h2;
-
-        // initialise pixmap array
-        initPixmap( _pixmaps, source, _w1, _h1, QRect(0, 0, _w1, _h1) );
-        initPixmap( _pixmaps, source, w, _h1, QRect(_w1, 0, w2, _h1) );
-        initPixmap( _pixmaps, source, _w3, _h1, QRect(_w1+w2, 0, _w3, _h1) );
-        initPixmap( _pixmaps, source, _w1, h, QRect(0, _h1, _w1, h2) );
-        initPixmap( _pixmaps, source, w, h, QRect(_w1, _h1, w2, h2) );
-        initPixmap( _pixmaps, source, _w3, h, QRect(_w1+w2, _h1, _w3, h2) );
-        initPixmap( _pixmaps, source, _w1, _h3, QRect(0, _h1+h2, _w1, _h3) );
-        initPixmap( _pixmaps, source, w, _h3, QRect(_w1, _h1+h2, w2, _h3) );
-        initPixmap( _pixmaps, source, _w3, _h3, QRect(_w1+w2, _h1+h2, _w3, _h3) );
+        const qreal dpiRatio( source.devicePixelRatio() );
+        _w3 = source.width()/dpiRatio - (w1 + w2);
+        _h3 = source.height()/dpiRatio - (h1 + h2);
+
+        // chunk rects in source, in device pixels, clipped to the source
+        const QRect sourceRect( QPoint( 0, 0 ), source.size() );
+        const int x[] = { 0, _w1, _w1 + _w2 };
+        const int y[] = { 0, _h1, _h1 + _h2 };
+        const int w[] = { _w1, _w2, _w3 };
+        const int h[] = { _h1, _h2, _h3 };
+
+        QRect chunks[9];
+        for( int row = 0; row < 3; ++row )
+        {
+            for( int column = 0; column < 3; ++column )
+            {
+                const QRect rect( x[column], y[row], w[column], h[row] );
+                chunks[3*row + column] = QRect( rect.topLeft()*dpiRatio, rect.size()*dpiRatio ) & sourceRect;
+            }
+        }
+
+        /*
+        chunks are stored in a single atlas, each surrounded by one pixel copied from its own edges,
+        so that smooth scaling of a chunk never samples the neighbouring ones
+        */
+        const int atlasWidth( chunks[0].width() + chunks[1].width() + chunks[2].width() + 6 );
+        const int atlasHeight( chunks[0].height() + chunks[3].height() + chunks[6].height() + 6 );
+        QImage atlas( atlasWidth, atlasHeight, QImage::Format_ARGB32_Premultiplied );
+        atlas.fill( Qt::transparent );
+
+        const QImage sourceImage( source.toImage().convertToFormat( QImage::Format_ARGB32_Premultiplied ) );
+        const int stride( sizeof( QRgb ) );
+
+        _sourceRects.reserve(9);
+        int top = 1;
+        for( int row = 0; row < 3; ++row )
+        {
+            int left = 1;
+            for( int column = 0; column < 3; ++column )
+            {
+                const QRect& chunk( chunks[3*row + column] );
+                const QRect target( left, top, chunk.width(), chunk.height() );
+                _sourceRects.append( target );
+                left += chunk.width() + 2;
+
+                if( chunk.isEmpty() ) continue;
+
+                // copy chunk, and replicate its left and right columns
+                for( int line = 0; line < chunk.height(); ++line )
+                {
+                    auto out = reinterpret_cast<QRgb*>( atlas.scanLine( target.top() + line ) );
+                    memcpy( out + target.left(), sourceImage.constScanLine( chunk.top() + line ) + chunk.left()*stride, chunk.width()*stride );
+                    out[target.left() - 1] = out[target.left()];
+                    out[target.right() + 1] = out[target.right()];
+                }
+
+                // replicate top and bottom rows, including corners
+                const int offset( (target.left() - 1)*stride );
+                const int length( (target.width() + 2)*stride );
+                memcpy( atlas.scanLine( target.top() - 1 ) + offset, atlas.constScanLine( target.top() ) + offset, length );
+                memcpy( atlas.scanLine( target.bottom() + 1 ) + offset, atlas.constScanLine( target.bottom() ) + offset, length );
+            }
+
+            top += chunks[3*row].height() + 2;
+        }
+
+        atlas.setDevicePixelRatio( dpiRatio );
+        _pixmap = QPixmap::fromImage( atlas );
     }
 
     //___________________________________________________________
-    void TileSet::render(const QRect &constRect, QPainter *painter, Tiles tiles) const
+    QImage TileSet::image( int index ) const
     {
 
-        const bool oldHint( painter->testRenderHint( QPainter::SmoothPixmapTransform ) );
-        painter->setRenderHint( QPainter::SmoothPixmapTransform, true );
+        if( !isValid() || index < 0 || index >= _sourceRects.size() ) return QImage();
+
+        if( _images.isEmpty() )
+        {
+            // convert the pixmap once, and store packed copies of all chunks
+            const QImage atlas( _pixmap.toImage() );
+            _images.reserve( _sourceRects.size() );
+            for( const auto& rect : _sourceRects )
+            { _images.append( rect.isEmpty() ? QImage():atlas.copy( rect ) ); }
+        }
+
+        return _images[index];
+
+    }
+
+    //___________________________________________________________
+    void TileSet::render(const QRect &constRect, QPainter *painter, Tiles tiles) const
+    {
 
         // check initialization
-        if( _pixmaps.size() < 9 ) return;
+        if( !isValid() ) return;
 
         // copy source rect
         QRect rect( constRect );
@@ -141,33 +169,49 @@ namespace Breeze
         const int y1 = y0 + hTop;
         const int y2 = y1 + h;
 
-        const int w2 = _pixmaps.at(7).width()/devicePixelRatio( _pixmaps.at(7) );
-        const int h2 = _pixmaps.at(5).height()/devicePixelRatio( _pixmaps.at(5) );
+        // collect fragments. Source rects are relative to the chunk, in logical pixels
+        const qreal dpiRatio( devicePixelRatio() );
+        QPainter::PixmapFragment fragments[9];
+        int count = 0;
+        auto addFragment = [&]( int index, const QRect& target, const QRect& source )
+        {
+            if( target.isEmpty() || source.isEmpty() ) return;
+            const QPointF origin( _sourceRects[index].topLeft() );
+            const QRectF scaledSource( origin + QPointF( source.topLeft() )*dpiRatio, QSizeF( source.size() )*dpiRatio );
+            fragments[count++] = QPainter::PixmapFragment::create(
+                QRectF( target ).center(), scaledSource,
+                target.width()/scaledSource.width(), target.height()/scaledSource.height() );
+        };
 
         // corner
-        if( bits( tiles, Top|Left) )  painter->drawPixmap(x0, y0, _pixmaps.at(0), 0, 0, wLeft*devicePixelRatio( _pixmaps.at(0) ), hTop*devicePixelRatio( _pixmaps.at(0) ));
-        if( bits( tiles, Top|Right) ) painter->drawPixmap(x2, y0, _pixmaps.at(2), (_w3-wRight)*devicePixelRatio( _pixmaps.at(2) ), 0, wRight*devicePixelRatio( _pixmaps.at(2) ), hTop*devicePixelRatio( _pixmaps.at(2) ) );
-        if( bits( tiles, Bottom|Left) )  painter->drawPixmap(x0, y2, _pixmaps.at(6), 0, (_h3-hBottom)*devicePixelRatio( _pixmaps.at(6) ), wLeft*devicePixelRatio( _pixmaps.at(6) ),  hBottom*devicePixelRatio( _pixmaps.at(6) ));
-        if( bits( tiles, Bottom|Right) ) painter->drawPixmap(x2, y2, _pixmaps.at(8), (_w3-wRight)*devicePixelRatio( _pixmaps.at(8) ), (_h3-hBottom)*devicePixelRatio( _pixmaps.at(8) ), wRight*devicePixelRatio( _pixmaps.at(8) ), hBottom*devicePixelRatio( _pixmaps.at(8) ) );
+        if( bits( tiles, Top|Left) ) addFragment( 0, QRect( x0, y0, wLeft, hTop ), QRect( 0, 0, wLeft, hTop ) );
+        if( bits( tiles, Top|Right) ) addFragment( 2, QRect( x2, y0, wRight, hTop ), QRect( _w3-wRight, 0, wRight, hTop ) );
+        if( bits( tiles, Bottom|Left) ) addFragment( 6, QRect( x0, y2, wLeft, hBottom ), QRect( 0, _h3-hBottom, wLeft, hBottom ) );
+        if( bits( tiles, Bottom|Right) ) addFragment( 8, QRect( x2, y2, wRight, hBottom ), QRect( _w3-wRight, _h3-hBottom, wRight, hBottom ) );
 
         // top and bottom
         if( w > 0 )
         {
-            if( tiles&Top ) painter->drawPixmap(x1, y0, w, hTop, _pixmaps.at(1), 0, 0, w2*devicePixelRatio( _pixmaps.at(1) ), hTop*devicePixelRatio( _pixmaps.at(1) ) );
-            if( tiles&Bottom ) painter->drawPixmap(x1, y2, w, hBottom, _pixmaps.at(7), 0, (_h3-hBottom)*devicePixelRatio( _pixmaps.at(7) ), w2*devicePixelRatio( _pixmaps.at(7) ), hBottom*devicePixelRatio( _pixmaps.at(7) ) );
+            if( tiles&Top ) addFragment( 1, QRect( x1, y0, w, hTop ), QRect( 0, 0, _w2, hTop ) );
+            if( tiles&Bottom ) addFragment( 7, QRect( x1, y2, w, hBottom ), QRect( 0, _h3-hBottom, _w2, hBottom ) );
         }
 
         // left and right
         if( h > 0 )
         {
-            if( tiles&Left ) painter->drawPixmap(x0, y1, wLeft, h, _pixmaps.at(3), 0, 0, wLeft*devicePixelRatio( _pixmaps.at(3) ), h2*devicePixelRatio( _pixmaps.at(3) ) );
-            if( tiles&Right ) painter->drawPixmap(x2, y1, wRight, h, _pixmaps.at(5), (_w3-wRight)*devicePixelRatio( _pixmaps.at(5) ), 0, wRight*devicePixelRatio( _pixmaps.at(5) ), h2*devicePixelRatio( _pixmaps.at(5) ) );
+            if( tiles&Left ) addFragment( 3, QRect( x0, y1, wLeft, h ), QRect( 0, 0, wLeft, _h2 ) );
+            if( tiles&Right ) addFragment( 5, QRect( x2, y1, wRight, h ), QRect( _w3-wRight, 0, wRight, _h2 ) );
         }
 
         // center
-        if( (tiles&Center) && h > 0 && w > 0 ) painter->drawPixmap(x1, y1, w, h, _pixmaps.at(4));
+        if( (tiles&Center) && h > 0 && w > 0 ) addFragment( 4, QRect( x1, y1, w, h ), QRect( 0, 0, _w2, _h2 ) );
+
+        if( !count ) return;
 
-        // restore
+        // render all fragments at once
+        const bool oldHint( painter->testRenderHint( QPainter::SmoothPixmapTransform ) );
+        painter->setRenderHint( QPainter::SmoothPixmapTransform, true );
+        painter->drawPixmapFragments( fragments, count, _pixmap );
         painter->setRenderHint( QPainter::SmoothPixmapTransform, oldHint );
 
     }
@@ -7,6 +7,7 @@
 #ifndef breezetileset_h
 #define breezetileset_h
 
+#include <QImage>
 #include <QPixmap>
 #include <QRect>
 #include <QVector>
@@ -15,6 +16,7 @@
 /**
 tilesets are collections of stretchable pixmaps corresponding to a given widget corners, sides, and center.
 corner pixmaps are never stretched. center pixmaps are
+all chunks are stored in a single padded pixmap, and drawn in a single batch
 */
 namespace Breeze
 {
@@ -77,28 +79,36 @@ namespace Breeze
 
         //* is valid
         bool isValid() const
-        { return _pixmaps.size() == 9; }
+        { return _sourceRects.size() == 9; }
 
-        //* returns pixmap for given index
-        QPixmap pixmap( int index ) const
-        { return _pixmaps[index]; }
+        //* device pixel ratio
+        qreal devicePixelRatio() const
+        { return _pixmap.devicePixelRatio(); }
 
-        protected:
+        //* source rect of chunk for given index, in device pixels
+        QRect sourceRect( int index ) const
+        { return _sourceRects[index]; }
 
-        //* shortcut to pixmap list
-        using PixmapList = QVector<QPixmap>;
-
-        //* initialize pixmap
-        void initPixmap( PixmapList&, const QPixmap&, int w, int h, const QRect& );
+        //* image of chunk for given index
+        /** chunk images are copied from the pixmap on first use, and cached */
+        QImage image( int index ) const;
 
         private:
 
-        //* pixmap arry
-        PixmapList _pixmaps;
+        //* all chunks
+        QPixmap _pixmap;
+
+        //* source rect of chunks in pixmap, in device pixels
+        QVector<QRect> _sourceRects;
+
+        //* chunk images, created on demand
+        mutable QVector<QImage> _images;
 
         // dimensions
         int _w1;
         int _h1;
+        int _w2;
+        int _h2;
         int _w3;
         int _h3;
 
@@ -57,12 +57,24 @@ namespace Breeze {
     {
         Q_ASSERT(window);
 
-        int itemHeight = window->menuWidget() ? window->menuWidget()->height() : 0;
-        for (auto item : _windows[window]) {
-            if (!item.isNull() && item->isVisible() && window->toolBarArea(item) == Qt::TopToolBarArea) {
-                itemHeight = qMax(item->mapTo(window, item->rect().bottomLeft()).y(), itemHeight);
+        // the bottom of the top toolbars is cached, and invalidated
+        // whenever one of them changes geometry, visibility or area
+        auto iter = _toolBarsBottom.constFind(window);
+        if (iter == _toolBarsBottom.constEnd()) {
+            int toolBarsBottom = 0;
+            for (auto item : _windows.value(window)) {
+                if (!item.isNull() && item->isVisible() && window->toolBarArea(item) == Qt::TopToolBarArea) {
+                    toolBarsBottom = qMax(item->mapTo(window, item->rect().bottomLeft()).y(), toolBarsBottom);
+                }
             }
+            iter = _toolBarsBottom.insert(window, toolBarsBottom);
+
+            // entries are keyed by address, make sure they do not outlive the window
+            connect(window, &QObject::destroyed, this, &ToolsAreaManager::windowDestroyed, Qt::UniqueConnection);
         }
+
+        int itemHeight = window->menuWidget() ? window->menuWidget()->height() : 0;
+        itemHeight = qMax(iter.value(), itemHeight);
         if (itemHeight > 0) {
             itemHeight += window->devicePixelRatio();
         }
@@ -70,6 +82,28 @@ namespace Breeze {
         return QRect(0, 0, window->width(), itemHeight);
     }
 
+    void ToolsAreaManager::windowDestroyed(QObject *object)
+    {
+        _toolBarsBottom.remove(static_cast<const QMainWindow*>(object));
+    }
+
+    void ToolsAreaManager::watchToolBar(QMainWindow *window, QToolBar *toolbar)
+    {
+        if (_toolBarWindows.contains(toolbar)) {
+            _toolBarWindows[toolbar] = window;
+            return;
+        }
+
+        _toolBarWindows.insert(toolbar, window);
+        toolbar->removeEventFilter(this);
+        toolbar->installEventFilter(this);
+        connect(toolbar, &QObject::destroyed, this, [this](QObject *object) {
+            if (auto window = _toolBarWindows.take(object)) {
+                _toolBarsBottom.remove(window);
+            }
+        });
+    }
+
     bool ToolsAreaManager::tryRegisterToolBar(QPointer<QMainWindow> window, QPointer<QWidget> widget)
     {
         Q_ASSERT(!widget.isNull());
@@ -77,9 +111,13 @@ namespace Breeze {
         QPointer<QToolBar> toolbar;
         if (!(toolbar = qobject_cast<QToolBar*>(widget))) return false;
 
+        // keep track of owning window, to follow area changes
+        watchToolBar(window, toolbar);
+
         if (window->toolBarArea(toolbar) == Qt::TopToolBarArea) {
             widget->setPalette(palette());
             appendIfNotAlreadyExists(&_windows[window], toolbar);
+            _toolBarsBottom.remove(window);
             return true;
         }
 
@@ -96,6 +134,7 @@ namespace Breeze {
         if (window->toolBarArea(toolbar) != Qt::TopToolBarArea) {
             widget->setPalette(window->palette());
             _windows[window].removeAll(toolbar);
+            _toolBarsBottom.remove(window);
         }
     }
 
@@ -160,35 +199,58 @@ namespace Breeze {
         Q_ASSERT(watched);
         Q_ASSERT(event);
 
-        QPointer<QObject> parent = watched;
-        QPointer<QMainWindow> mainWindow = nullptr;
-        while (parent != nullptr) {
-            if (qobject_cast<QMainWindow*>(parent)) {
-                mainWindow = qobject_cast<QMainWindow*>(parent);
-                break;
+        // filter on event type before doing any other work
+        switch (event->type()) {
+        case QEvent::ChildAdded:
+        case QEvent::ChildRemoved: {
+            auto mw = qobject_cast<QMainWindow*>(watched);
+            if (!mw) {
+                return false;
             }
-            parent = parent->parent();
-        }
-
-        if (QPointer<QMainWindow> mw = qobject_cast<QMainWindow*>(watched)) {
-            QChildEvent *ev = nullptr;
-            if (event->type() == QEvent::ChildAdded || event->type() == QEvent::ChildRemoved)
-                ev = static_cast<QChildEvent*>(event);
 
+            auto ev = static_cast<QChildEvent*>(event);
             QPointer<QToolBar> tb = qobject_cast<QToolBar*>(ev->child());
-            if (tb.isNull())
+            if (tb.isNull()) {
                 return false;
+            }
 
             if (ev->added()) {
-                if (mw->toolBarArea(tb) == Qt::TopToolBarArea)
+                watchToolBar(mw, tb);
+                if (mw->toolBarArea(tb) == Qt::TopToolBarArea) {
                     appendIfNotAlreadyExists(&_windows[mw], tb);
+                }
             } else if (ev->removed()) {
                 _windows[mw].removeAll(tb);
             }
-        } else if (qobject_cast<QToolBar*>(watched)) {
-            if (!mainWindow.isNull()) {
-                tryUnregisterToolBar(mainWindow, qobject_cast<QWidget*>(watched));
+            _toolBarsBottom.remove(mw);
+            break;
+        }
+
+        case QEvent::Move:
+        case QEvent::Resize:
+        case QEvent::Show:
+        case QEvent::Hide: {
+            // toolbar geometry or visibility changed, use cached owning window
+            auto iter = _toolBarWindows.constFind(watched);
+            if (iter == _toolBarWindows.constEnd() || iter.value().isNull()) {
+                return false;
+            }
+
+            QPointer<QMainWindow> mainWindow = iter.value();
+            _toolBarsBottom.remove(mainWindow);
+
+            // toolbar might have been moved to another area
+            auto toolbar = static_cast<QToolBar*>(watched);
+            if (_windows.value(mainWindow).contains(toolbar)) {
+                tryUnregisterToolBar(mainWindow, toolbar);
+            } else if (event->type() == QEvent::Move || event->type() == QEvent::Show) {
+                tryRegisterToolBar(mainWindow, toolbar);
             }
+            break;
+        }
+
+        default:
+            break;
         }
 
         return false;
@@ -215,6 +277,13 @@ namespace Breeze {
         if (mainWindow != mainWindow->window()) {
             return;
         }
+        if (mainWindow == widget) {
+            // watch for toolbars being added or removed
+            widget->removeEventFilter(this);
+            widget->installEventFilter(this);
+            _toolBarsBottom.remove(mainWindow);
+            return;
+        }
         tryRegisterToolBar(mainWindow, widget);
     }
 
@@ -224,7 +293,9 @@ namespace Breeze {
         auto ptr = QPointer<QWidget>(widget);
 
         if (QPointer<QMainWindow> window = qobject_cast<QMainWindow*>(ptr)) {
+            window->removeEventFilter(this);
             _windows.remove(window);
+            _toolBarsBottom.remove(window);
             return;
         } else if (QPointer<QToolBar> toolbar = qobject_cast<QToolBar*>(ptr)) {
             auto parent = ptr;
@@ -238,7 +309,10 @@ namespace Breeze {
             } if (mainWindow == nullptr) {
                 return;
             }
+            toolbar->removeEventFilter(this);
+            _toolBarWindows.remove(toolbar);
             _windows[mainWindow].removeAll(toolbar);
+            _toolBarsBottom.remove(mainWindow);
         }
     }
 
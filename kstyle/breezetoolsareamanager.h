@@ -33,6 +33,10 @@ namespace Breeze {
     private:
         Helper* _helper;
         QHash<const QMainWindow*,QVector<QPointer<QToolBar>>> _windows;
+        // owning main window, per watched toolbar
+        QHash<const QObject*,QPointer<QMainWindow>> _toolBarWindows;
+        // cached bottom of the top area toolbars, per main window
+        QHash<const QMainWindow*,int> _toolBarsBottom;
         KSharedConfigPtr _config;
         KConfigWatcher::Ptr _watcher;
         QPalette _palette = QPalette();
@@ -44,7 +48,10 @@ namespace Breeze {
     protected:
         bool tryRegisterToolBar(QPointer<QMainWindow> window, QPointer<QWidget> widget);
         void tryUnregisterToolBar(QPointer<QMainWindow> window, QPointer<QWidget> widget);
+        void watchToolBar(QMainWindow *window, QToolBar *toolbar);
         void configUpdated();
+        // drop cached data of a destroyed main window
+        void windowDestroyed(QObject *object);
 
     public:
         explicit ToolsAreaManager(Helper *helper, QObject *parent = nullptr);
@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Breeze Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "breezewidgetflagcache.h"
+#include "breezepropertynames.h"
+
+namespace Breeze
+{
+
+    //_______________________________________________________
+    bool WidgetFlagCache::find( const QObject* object, Flag flag, bool& value ) const
+    {
+
+        auto iter = _data.constFind( object );
+        if( iter == _data.constEnd() || !iter->known.testFlag( flag ) ) return false;
+
+        value = iter->values.testFlag( flag );
+        return true;
+
+    }
+
+    //_______________________________________________________
+    void WidgetFlagCache::insert( const QObject* object, Flag flag, bool value )
+    {
+
+        auto iter = _data.find( object );
+        if( iter == _data.end() )
+        {
+
+            // first entry for this object, make sure it gets invalidated and removed on destruction
+            const_cast<QObject*>( object )->installEventFilter( this );
+            connect( object, &QObject::destroyed, this, &WidgetFlagCache::objectDestroyed, Qt::UniqueConnection );
+            iter = _data.insert( object, Entry() );
+
+        }
+
+        iter->known |= flag;
+        iter->values.setFlag( flag, value );
+
+    }
+
+    //_______________________________________________________
+    bool WidgetFlagCache::eventFilter( QObject* object, QEvent* event )
+    {
+
+        switch( event->type() )
+        {
+
+            case QEvent::ParentChange:
+            {
+                // all flags may depend on the ancestors, of the object and of its children
+                auto iter = _data.find( object );
+                if( iter != _data.end() ) *iter = Entry();
+
+                foreach( auto child, object->findChildren<QObject*>() )
+                {
+                    iter = _data.find( child );
+                    if( iter != _data.end() ) *iter = Entry();
+                }
+
+                break;
+            }
+
+            case QEvent::DynamicPropertyChange:
+            {
+                const auto propertyEvent = static_cast<QDynamicPropertyChangeEvent*>( event );
+                if( propertyEvent->propertyName() != PropertyNames::highlightNeutral ) break;
+
+                auto iter = _data.find( object );
+                if( iter != _data.end() ) iter->known.setFlag( HighlightNeutral, false );
+                break;
+            }
+
+            default: break;
+
+        }
+
+        // never eat events
+        return false;
+
+    }
+
+}
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Breeze Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef breezewidgetflagcache_h
+#define breezewidgetflagcache_h
+
+#include <QEvent>
+#include <QFlags>
+#include <QHash>
+#include <QObject>
+
+namespace Breeze
+{
+
+    //* typed, pointer-keyed storage of per-widget style flags
+    /**
+    flags are computed lazily by the style and stored here rather than in dynamic properties.
+    Entries are dropped when the object is destroyed or unpolished. They are invalidated when the object,
+    or one of its ancestors, is reparented, and the neutral highlight flag is invalidated when the matching
+    dynamic property is changed. Both events are caught by an event filter installed on cached objects.
+    */
+    class WidgetFlagCache: public QObject
+    {
+
+        Q_OBJECT
+
+        public:
+
+        //* cached flags
+        enum Flag
+        {
+            MenuTitle = 1<<0,
+            AlteredBackground = 1<<1,
+            HighlightNeutral = 1<<2
+        };
+
+        Q_DECLARE_FLAGS( Flags, Flag )
+
+        //* constructor
+        explicit WidgetFlagCache( QObject* parent ):
+            QObject( parent )
+        {}
+
+        //* retrieve flag. Returns false if not cached
+        bool find( const QObject*, Flag, bool& value ) const;
+
+        //* store flag
+        void insert( const QObject*, Flag, bool value );
+
+        //* remove object from cache
+        void remove( QObject* object )
+        {
+            object->removeEventFilter( this );
+            _data.remove( object );
+        }
+
+        //* clear all stored flags
+        void clear()
+        { _data.clear(); }
+
+        //* event filter
+        bool eventFilter( QObject*, QEvent* ) override;
+
+        protected Q_SLOTS:
+
+        //* remove object from cache
+        void objectDestroyed( QObject* object )
+        { _data.remove( object ); }
+
+        private:
+
+        //* cache entry
+        struct Entry
+        {
+            //* flags for which a value is stored
+            Flags known;
+
+            //* flag values
+            Flags values;
+        };
+
+        //* data
+        QHash<const QObject*, Entry> _data;
+
+    };
+
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS( Breeze::WidgetFlagCache::Flags )
+
+#endif
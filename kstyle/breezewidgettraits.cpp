@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Breeze Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "breezewidgettraits.h"
+
+#include <QAbstractItemView>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QCommandLinkButton>
+#include <QDial>
+#include <QDialog>
+#include <QDockWidget>
+#include <QGroupBox>
+#include <QHash>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMainWindow>
+#include <QMdiSubWindow>
+#include <QMenu>
+#include <QMenuBar>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QRadioButton>
+#include <QScrollBar>
+#include <QSlider>
+#include <QSpinBox>
+#include <QSplitterHandle>
+#include <QStackedWidget>
+#include <QStatusBar>
+#include <QTabBar>
+#include <QTextEdit>
+#include <QToolBar>
+#include <QToolBox>
+#include <QToolButton>
+
+namespace
+{
+
+    //* true if class or one of its ancestors matches a given class name
+    /** same as QObject::inherits, for classes whose headers are not available */
+    bool inheritsClass( const QMetaObject* metaObject, const char* className )
+    {
+        for( ; metaObject; metaObject = metaObject->superClass() )
+        { if( qstrcmp( metaObject->className(), className ) == 0 ) return true; }
+        return false;
+    }
+
+    //* true if class inherits a given type
+    template<typename T> bool inheritsType( const QMetaObject* metaObject )
+    { return metaObject->inherits( &T::staticMetaObject ); }
+
+}
+
+namespace Breeze
+{
+
+    //* cached traits, per class. Traits are only accessed from the GUI thread
+    static QHash<const QMetaObject*, WidgetTraits> s_cache;
+
+    //_______________________________________________________
+    WidgetTraits WidgetTraits::get( const QMetaObject* metaObject )
+    {
+
+        if( !metaObject ) return WidgetTraits();
+
+        auto iter = s_cache.constFind( metaObject );
+        if( iter == s_cache.constEnd() ) iter = s_cache.insert( metaObject, compute( metaObject ) );
+        return iter.value();
+
+    }
+
+    //_______________________________________________________
+    void WidgetTraits::clearCache()
+    { s_cache.clear(); }
+
+    //_______________________________________________________
+    WidgetTraits WidgetTraits::compute( const QMetaObject* metaObject )
+    {
+
+        WidgetTraits traits;
+
+        // types
+        const struct
+        {
+            Type type;
+            bool match;
+        } types[] = {
+            { ScrollArea, inheritsType<QAbstractScrollArea>( metaObject ) },
+            { ItemView, inheritsType<QAbstractItemView>( metaObject ) },
+            { TextEditorView, inheritsClass( metaObject, "KTextEditor::View" ) },
+            { ComboBox, inheritsType<QComboBox>( metaObject ) },
+            { ComboBoxContainer, inheritsClass( metaObject, "QComboBoxPrivateContainer" ) },
+            { AbstractButton, inheritsType<QAbstractButton>( metaObject ) },
+            { ToolButton, inheritsType<QToolButton>( metaObject ) },
+            { CommandLinkButton, inheritsType<QCommandLinkButton>( metaObject ) },
+            { ScrollBar, inheritsType<QScrollBar>( metaObject ) },
+            { GroupBox, inheritsType<QGroupBox>( metaObject ) },
+            { Frame, inheritsType<QFrame>( metaObject ) },
+            { DockWidget, inheritsType<QDockWidget>( metaObject ) },
+            { MdiSubWindow, inheritsType<QMdiSubWindow>( metaObject ) },
+            { ToolBox, inheritsType<QToolBox>( metaObject ) },
+            { Menu, inheritsType<QMenu>( metaObject ) },
+            { ToolTipLabel, inheritsClass( metaObject, "QTipLabel" ) },
+            { MainWindow, inheritsType<QMainWindow>( metaObject ) },
+            { Dialog, inheritsType<QDialog>( metaObject ) },
+            { ToolBar, inheritsType<QToolBar>( metaObject ) },
+            { StackedWidget, inheritsType<QStackedWidget>( metaObject ) },
+            { TitleWidget, inheritsClass( metaObject, "KTitleWidget" ) },
+            { QuickWidget, inheritsClass( metaObject, "QQuickWidget" ) },
+            { Label, inheritsType<QLabel>( metaObject ) }
+        };
+
+        for( const auto& entry : types )
+        { if( entry.match ) traits.types |= entry.type; }
+
+        // mouse over effects
+        traits.hover =
+            traits.is( ItemView|ComboBox|ScrollBar|ToolButton|TextEditorView )
+            || inheritsType<QAbstractSpinBox>( metaObject )
+            || inheritsType<QCheckBox>( metaObject )
+            || inheritsType<QDial>( metaObject )
+            || inheritsType<QLineEdit>( metaObject )
+            || inheritsType<QPushButton>( metaObject )
+            || inheritsType<QRadioButton>( metaObject )
+            || inheritsType<QSlider>( metaObject )
+            || inheritsType<QSplitterHandle>( metaObject )
+            || inheritsType<QTabBar>( metaObject )
+            || inheritsType<QTextEdit>( metaObject );
+
+        // animations
+        // order matters, since a widget is registered to at most one engine
+        if( traits.is( ToolButton ) ) traits.animation = AnimateToolButton;
+        else if( inheritsType<QCheckBox>( metaObject ) || inheritsType<QRadioButton>( metaObject ) ) traits.animation = AnimateCheckBox;
+        else if( traits.is( AbstractButton ) ) traits.animation = AnimateButton;
+        else if( traits.is( GroupBox ) ) traits.animation = AnimateGroupBox;
+        else if( traits.is( ScrollBar ) ) traits.animation = AnimateScrollBar;
+        else if( inheritsType<QSlider>( metaObject ) ) traits.animation = AnimateSlider;
+        else if( inheritsType<QDial>( metaObject ) ) traits.animation = AnimateDial;
+        else if( inheritsType<QProgressBar>( metaObject ) ) traits.animation = AnimateProgressBar;
+        else if( traits.is( ComboBox ) ) traits.animation = AnimateComboBox;
+        else if( inheritsType<QSpinBox>( metaObject ) ) traits.animation = AnimateSpinBox;
+        else if( inheritsType<QLineEdit>( metaObject ) || inheritsType<QTextEdit>( metaObject ) || traits.is( TextEditorView ) ) traits.animation = AnimateInputWidget;
+        else if( inheritsType<QHeaderView>( metaObject ) ) traits.animation = AnimateHeaderView;
+        else if( traits.is( ItemView ) ) traits.animation = AnimateInputWidget;
+        else if( inheritsType<QTabBar>( metaObject ) ) traits.animation = AnimateTabBar;
+        else if( traits.is( ScrollArea ) ) traits.animation = AnimateScrollArea;
+
+        // window drag
+        if( traits.is( GroupBox ) ) traits.dragPolicy = DragAlways;
+        else if( traits.is( Dialog|MainWindow ) ) traits.dragPolicy = DragIfWindow;
+        else if( traits.is( ToolBar ) || inheritsType<QMenuBar>( metaObject ) || inheritsType<QTabBar>( metaObject ) || inheritsType<QStatusBar>( metaObject ) ) traits.dragPolicy = DragIfNotDockWidgetTitle;
+        else if( inheritsClass( metaObject, "KScreenSaver" ) && inheritsClass( metaObject, "KCModule" ) ) traits.dragPolicy = DragAlways;
+        else if( traits.is( ToolButton ) ) traits.dragPolicy = DragIfFlat;
+        else if( traits.is( Label ) ) traits.dragPolicy = DragIfInStatusBar;
+
+        // shadows
+        if( traits.is( Menu|ComboBoxContainer|DockWidget|ToolBar ) ) traits.shadowPolicy = ShadowAccept;
+        else if( inheritsClass( metaObject, "Plasma::ToolTip" ) ) traits.shadowPolicy = ShadowReject;
+        else if( traits.is( ToolTipLabel ) ) traits.shadowPolicy = ShadowAccept;
+
+        return traits;
+
+    }
+
+}
@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Breeze Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef breezewidgettraits_h
+#define breezewidgettraits_h
+
+#include <QFlags>
+#include <QObject>
+
+namespace Breeze
+{
+
+    //* class-wide widget traits
+    /**
+    traits only depend on the widget class hierarchy. They are computed once per QMetaObject,
+    cached, and looked up by pointer, so that polishing, event filtering and engine registration
+    do not need to run chains of qobject_cast and string based inherits() checks for every widget.
+    Per-instance conditions (parent, window flags, dynamic properties) must still be checked by the caller.
+    */
+    class WidgetTraits
+    {
+
+        public:
+
+        //* widget types relevant to the style
+        enum Type
+        {
+            NoType = 0,
+            ScrollArea = 1<<0,
+            ItemView = 1<<1,
+            TextEditorView = 1<<2,
+            ComboBox = 1<<3,
+            ComboBoxContainer = 1<<4,
+            AbstractButton = 1<<5,
+            ToolButton = 1<<6,
+            CommandLinkButton = 1<<7,
+            ScrollBar = 1<<8,
+            GroupBox = 1<<9,
+            Frame = 1<<10,
+            DockWidget = 1<<11,
+            MdiSubWindow = 1<<12,
+            ToolBox = 1<<13,
+            Menu = 1<<14,
+            ToolTipLabel = 1<<15,
+            MainWindow = 1<<16,
+            Dialog = 1<<17,
+            ToolBar = 1<<18,
+            StackedWidget = 1<<19,
+            TitleWidget = 1<<20,
+            QuickWidget = 1<<21,
+            Label = 1<<22
+        };
+
+        Q_DECLARE_FLAGS( Types, Type )
+
+        //* animation engine to which widgets are registered
+        enum AnimationTarget
+        {
+            AnimateNone,
+            AnimateToolButton,
+            AnimateCheckBox,
+            AnimateButton,
+            AnimateGroupBox,
+            AnimateScrollBar,
+            AnimateSlider,
+            AnimateDial,
+            AnimateProgressBar,
+            AnimateComboBox,
+            AnimateSpinBox,
+            AnimateInputWidget,
+            AnimateHeaderView,
+            AnimateTabBar,
+            AnimateScrollArea
+        };
+
+        //* window drag policy
+        enum DragPolicy
+        {
+            //* only when white listed, or when the widget is a suitable viewport
+            DragIfListed,
+
+            //* always dragable
+            DragAlways,
+
+            //* dragable when toplevel
+            DragIfWindow,
+
+            //* dragable unless used as a dock widget title
+            DragIfNotDockWidgetTitle,
+
+            //* dragable if flat (auto-raise tool buttons)
+            DragIfFlat,
+
+            //* dragable if inside a status bar (labels)
+            DragIfInStatusBar
+        };
+
+        //* shadow acceptance policy
+        enum ShadowPolicy
+        {
+            //* shadow only if the window flags are those of a tooltip
+            ShadowIfToolTip,
+
+            //* always accept shadow
+            ShadowAccept,
+
+            //* never accept shadow
+            ShadowReject
+        };
+
+        //* types
+        Types types = NoType;
+
+        //* true if mouse over effects must be enabled
+        bool hover = false;
+
+        //* animation target
+        AnimationTarget animation = AnimateNone;
+
+        //* drag policy
+        DragPolicy dragPolicy = DragIfListed;
+
+        //* shadow policy
+        ShadowPolicy shadowPolicy = ShadowIfToolTip;
+
+        //* true if one of the given types matches
+        bool is( Types value ) const
+        { return types & value; }
+
+        //* traits for a given object
+        static WidgetTraits get( const QObject* object )
+        { return object ? get( object->metaObject() ) : WidgetTraits(); }
+
+        //* traits for a given class
+        static WidgetTraits get( const QMetaObject* );
+
+        //* drop cached traits
+        /** metaobjects from unloaded plugins must not remain in the cache */
+        static void clearCache();
+
+        private:
+
+        //* compute traits for a given class
+        static WidgetTraits compute( const QMetaObject* );
+
+    };
+
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS( Breeze::WidgetTraits::Types )
+
+#endif
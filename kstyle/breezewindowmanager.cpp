@@ -12,6 +12,7 @@
 #include "breezewindowmanager.h"
 #include "breezepropertynames.h"
 #include "breezehelper.h"
+#include "breezewidgettraits.h"
 
 #include <QComboBox>
 #include <QDialog>
@@ -162,7 +163,7 @@ namespace Breeze
     void WindowManager::registerWidget( QWidget* widget )
     {
 
-        if( isBlackListed( widget ) || isDragable( widget ) || widget->inherits( "QQuickWidget" ) )
+        if( isBlackListed( widget ) || isDragable( widget ) || WidgetTraits::get( widget ).is( WidgetTraits::QuickWidget ) )
         {
 
             /*
@@ -203,6 +204,8 @@ namespace Breeze
     void WindowManager::initializeWhiteList()
     {
 
+        _whiteListedClasses.clear();
+
         _whiteList = Util::makeT<ExceptionSet>({
             ExceptionId( QStringLiteral( "MplayerWindow" ) ),
             ExceptionId( QStringLiteral( "ViewSliders@kmix" ) ),
@@ -221,6 +224,8 @@ namespace Breeze
     void WindowManager::initializeBlackList()
     {
 
+        _blackListedClasses.clear();
+
         _blackList = Util::makeT<ExceptionSet>({
             ExceptionId( QStringLiteral( "CustomTrackView@kdenlive" ) ),
             ExceptionId( QStringLiteral( "MuseScore" ) ),
@@ -311,7 +316,7 @@ namespace Breeze
         // If we are in a QQuickWidget we don't want to ever do dragging from a qwidget in the
         // hyerarchy, but only from an internal item, if any. If any event handler will manage
         // the event, we don't want the drag to start
-        if( object->inherits( "QQuickWidget" ) ) {
+        if( WidgetTraits::get( object ).is( WidgetTraits::QuickWidget ) ) {
             _eventInQQuickWidget = true;
             event->setAccepted(false);
             return false;
@@ -429,30 +434,30 @@ namespace Breeze
         // check widget
         if( !widget ) return false;
 
-        // accepted default types
-        if(
-            ( qobject_cast<QDialog*>( widget ) && widget->isWindow() ) ||
-            ( qobject_cast<QMainWindow*>( widget ) && widget->isWindow() ) ||
-            qobject_cast<QGroupBox*>( widget ) )
-        { return true; }
+        // accepted types, from class-wide drag policy
+        const auto dragPolicy( WidgetTraits::get( widget ).dragPolicy );
+        switch( dragPolicy )
+        {
+            case WidgetTraits::DragAlways: return true;
 
-        // more accepted types, provided they are not dock widget titles
-        if( ( qobject_cast<QMenuBar*>( widget ) ||
-            qobject_cast<QTabBar*>( widget ) ||
-            qobject_cast<QStatusBar*>( widget ) ||
-            qobject_cast<QToolBar*>( widget ) ) &&
-            !isDockWidgetTitle( widget ) )
-        { return true; }
+            case WidgetTraits::DragIfWindow:
+            if( widget->isWindow() ) return true;
+            break;
 
-        if( widget->inherits( "KScreenSaver" ) && widget->inherits( "KCModule" ) )
-        { return true; }
+            // provided they are not dock widget titles
+            case WidgetTraits::DragIfNotDockWidgetTitle:
+            if( !isDockWidgetTitle( widget ) ) return true;
+            break;
+
+            default: break;
+        }
 
         if( isWhiteListed( widget ) )
         { return true; }
 
         // flat toolbuttons
-        if( auto toolButton = qobject_cast<QToolButton*>( widget ) )
-        { if( toolButton->autoRaise() ) return true; }
+        if( dragPolicy == WidgetTraits::DragIfFlat )
+        { if( static_cast<QToolButton*>( widget )->autoRaise() ) return true; }
 
         // viewports
         /*
@@ -472,8 +477,9 @@ namespace Breeze
         this is because of kstatusbar
         who captures buttonPress/release events
         */
-        if( auto label = qobject_cast<QLabel*>( widget ) )
+        if( dragPolicy == WidgetTraits::DragIfInStatusBar )
         {
+            auto label = static_cast<QLabel*>( widget );
             if( label->textInteractionFlags().testFlag( Qt::TextSelectableByMouse ) ) return false;
 
             QWidget* parent = label->parentWidget();
@@ -496,36 +502,71 @@ namespace Breeze
         const auto propertyValue( widget->property( PropertyNames::noWindowGrab ) );
         if( propertyValue.isValid() && propertyValue.toBool() ) return true;
 
-        // list-based blacklisted widgets
-        const auto appName( qApp->applicationName() );
+        // list-based blacklisted widgets, cached per class
+        checkListedClasses();
+        const auto metaObject( widget->metaObject() );
+        auto iter = _blackListedClasses.constFind( metaObject );
+        if( iter != _blackListedClasses.constEnd() ) return iter.value();
+
+        bool blackListed( false );
         foreach( const ExceptionId& id, _blackList )
         {
-            if( !id.appName().isEmpty() && id.appName() != appName ) continue;
+            if( !id.appName().isEmpty() && id.appName() != _listedClassesAppName ) continue;
             if( id.className() == QStringLiteral( "*" ) && !id.appName().isEmpty() )
             {
                 // if application name matches and all classes are selected
                 // disable the grabbing entirely
                 setEnabled( false );
-                return true;
+                blackListed = true;
+                break;
+            }
+            if( widget->inherits( id.className().toLatin1().data() ) )
+            {
+                blackListed = true;
+                break;
             }
-            if( widget->inherits( id.className().toLatin1().data() ) ) return true;
         }
 
-        return false;
+        _blackListedClasses.insert( metaObject, blackListed );
+        return blackListed;
     }
 
     //_____________________________________________________________
     bool WindowManager::isWhiteListed( QWidget* widget ) const
     {
 
-        const auto appName( qApp->applicationName() );
+        // list-based whitelisted widgets, cached per class
+        checkListedClasses();
+        const auto metaObject( widget->metaObject() );
+        auto iter = _whiteListedClasses.constFind( metaObject );
+        if( iter != _whiteListedClasses.constEnd() ) return iter.value();
+
+        bool whiteListed( false );
         foreach( const ExceptionId& id, _whiteList )
         {
-            if( !(id.appName().isEmpty() || id.appName() == appName ) ) continue;
-            if( widget->inherits( id.className().toLatin1().data() ) ) return true;
+            if( !(id.appName().isEmpty() || id.appName() == _listedClassesAppName ) ) continue;
+            if( widget->inherits( id.className().toLatin1().data() ) )
+            {
+                whiteListed = true;
+                break;
+            }
         }
 
-        return false;
+        _whiteListedClasses.insert( metaObject, whiteListed );
+        return whiteListed;
+    }
+
+    //_____________________________________________________________
+    void WindowManager::checkListedClasses() const
+    {
+        // list entries may be restricted to a given application,
+        // so cached results are dropped whenever the application name changes
+        const auto appName( qApp->applicationName() );
+        if( appName == _listedClassesAppName ) return;
+
+        _listedClassesAppName = appName;
+        _whiteListedClasses.clear();
+        _blackListedClasses.clear();
     }
 
     //_____________________________________________________________
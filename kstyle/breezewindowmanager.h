@@ -15,6 +15,7 @@
 
 #include <QApplication>
 #include <QBasicTimer>
+#include <QHash>
 #include <QObject>
 #include <QSet>
 #include <QString>
@@ -122,6 +123,9 @@ namespace Breeze
         //* returns true if widget is dragable
         bool isWhiteListed( QWidget* ) const;
 
+        //* drop cached black/white list matches if application name has changed
+        void checkListedClasses() const;
+
         //* returns true if drag can be started from current widget
         bool canDrag( QWidget* );
 
@@ -218,6 +222,13 @@ namespace Breeze
         */
         ExceptionSet _blackList;
 
+        //*@name black and white list matches, cached per class
+        //@{
+        mutable QHash<const QMetaObject*, bool> _whiteListedClasses;
+        mutable QHash<const QMetaObject*, bool> _blackListedClasses;
+        mutable QString _listedClassesAppName;
+        //@}
+
         //* drag point
         QPoint _dragPoint;
         QPoint _globalDragPoint;
@@ -0,0 +1,214 @@
+/*
+ * SPDX-FileCopyrightText: 2021 Breeze Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+// own
+#include "breezeboxshadowrenderer.h"
+
+// Qt
+#include <QTest>
+#include <QtConcurrentMap>
+
+// std
+#include <cmath>
+
+using namespace Breeze;
+
+class BoxShadowRendererTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testBlurAccuracy_data();
+    void testBlurAccuracy();
+    void testDownsampling_data();
+    void testDownsampling();
+    void testConcurrentRendering();
+};
+
+/**
+ * Measure how far a blurred edge is from a true gaussian.
+ *
+ * The box is much larger than the blur and has no rounded corners, so the middle
+ * row of the shadow crosses a straight edge, which is a step blurred by a gaussian
+ * of standard deviation radius / 2.
+ *
+ * @returns The maximum error along the middle row, out of 255.
+ **/
+static qreal maxStepError(BoxShadowRenderer::BlurMethod method, int radius)
+{
+    const QSize boxSize(8 * radius, 8 * radius);
+
+    BoxShadowRenderer renderer;
+    renderer.setBoxSize(boxSize);
+    renderer.setBlurMethod(method);
+    renderer.addShadow(QPoint(0, 0), radius, Qt::black);
+
+    const QImage shadow = renderer.render();
+
+    const int edge = (shadow.width() - boxSize.width()) / 2;
+    const qreal stdDev = radius * 0.5;
+    const QRgb *line = reinterpret_cast<const QRgb *>(shadow.constScanLine(shadow.height() / 2));
+
+    qreal maxError = 0.0;
+    for (int x = 0; x < shadow.width() / 2; ++x) {
+        const qreal expected = 255.0 * 0.5 * std::erfc(-(x + 0.5 - edge) / (stdDev * M_SQRT2));
+        maxError = qMax(maxError, qAbs(qAlpha(line[x]) - expected));
+    }
+
+    return maxError;
+}
+
+void BoxShadowRendererTest::testBlurAccuracy_data()
+{
+    QTest::addColumn<int>("radius");
+
+    for (int radius : {8, 16, 32, 64, 128, 256}) {
+        QTest::addRow("radius %d", radius) << radius;
+    }
+}
+
+void BoxShadowRendererTest::testBlurAccuracy()
+{
+    QFETCH(int, radius);
+
+    const qreal boxError = maxStepError(BoxShadowRenderer::BlurMethod::Box, radius);
+    const qreal recursiveError = maxStepError(BoxShadowRenderer::BlurMethod::RecursiveGaussian, radius);
+
+    // Both methods stay within 2% of a true gaussian, and the recursive filter
+    // is about as accurate as the box filters it replaces.
+    QVERIFY2(boxError <= 5.0, qPrintable(QStringLiteral("box blur error: %1").arg(boxError)));
+    QVERIFY2(recursiveError <= 5.0, qPrintable(QStringLiteral("recursive blur error: %1").arg(recursiveError)));
+    QVERIFY2(recursiveError <= boxError + 1.0,
+             qPrintable(QStringLiteral("recursive blur error: %1, box blur error: %2").arg(recursiveError).arg(boxError)));
+}
+
+void BoxShadowRendererTest::testDownsampling_data()
+{
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<qreal>("dpr");
+
+    for (qreal dpr : {1.0, 2.0}) {
+        for (int radius : {16, 24, 32, 48, 64, 96, 128}) {
+            QTest::addRow("radius %d, dpr %g", radius, dpr) << radius << dpr;
+        }
+    }
+}
+
+void BoxShadowRendererTest::testDownsampling()
+{
+    QFETCH(int, radius);
+    QFETCH(qreal, dpr);
+
+    BoxShadowRenderer renderer;
+    renderer.setBoxSize(QSize(2 * radius + 7, 2 * radius + 7));
+    renderer.setDevicePixelRatio(dpr);
+    renderer.addShadow(QPoint(0, 0), radius, Qt::black);
+
+    const QImage reference = renderer.render();
+
+    renderer.setDownsamplingEnabled(true);
+    const QImage downsampled = renderer.render();
+
+    QCOMPARE(downsampled.size(), reference.size());
+
+    int maxError = 0;
+    for (int y = 0; y < reference.height(); ++y) {
+        const QRgb *referenceLine = reinterpret_cast<const QRgb *>(reference.constScanLine(y));
+        const QRgb *downsampledLine = reinterpret_cast<const QRgb *>(downsampled.constScanLine(y));
+        for (int x = 0; x < reference.width(); ++x) {
+            maxError = qMax(maxError, qAbs(qAlpha(referenceLine[x]) - qAlpha(downsampledLine[x])));
+        }
+    }
+
+    // Same bound as the blur accuracy: the difference comes mostly from the box
+    // filters approximating the gaussian differently at both resolutions.
+    QVERIFY2(maxError <= 5, qPrintable(QStringLiteral("downsampling error: %1").arg(maxError)));
+}
+
+struct ShadowConfig {
+    int size;
+    int strength;
+    qreal dpr;
+};
+
+/**
+ * Render a shadow the way decorations do.
+ *
+ * @param config The size index, strength and device pixel ratio.
+ * @param arena Working memory to use, if any.
+ **/
+static QImage renderShadow(const ShadowConfig &config, BoxShadowRenderer::ScratchArena *arena)
+{
+    // Radii and offsets of the small, medium, large and very large decoration shadows.
+    const struct {
+        int radius1;
+        int radius2;
+        QPoint offset2;
+    } params[] = {
+        {16, 8, QPoint(0, -2)},
+        {32, 16, QPoint(0, -4)},
+        {48, 24, QPoint(0, -6)},
+        {64, 32, QPoint(0, -8)},
+    };
+    const auto &param = params[config.size];
+
+    QColor color1(Qt::black);
+    color1.setAlphaF(config.strength / 255.0);
+    QColor color2(Qt::black);
+    color2.setAlphaF(0.3 * config.strength / 255.0);
+
+    BoxShadowRenderer renderer;
+    renderer.setBoxSize(BoxShadowRenderer::calculateMinimumBoxSize(param.radius1));
+    renderer.setBorderRadius(3.5);
+    renderer.setDevicePixelRatio(config.dpr);
+    renderer.setDownsamplingEnabled(true);
+    renderer.addShadow(QPoint(0, 0), param.radius1, color1);
+    renderer.addShadow(param.offset2, param.radius2, color2);
+
+    return renderer.render(arena);
+}
+
+static QImage renderShadowWithThreadArena(const ShadowConfig &config)
+{
+    static thread_local BoxShadowRenderer::ScratchArena arena;
+    return renderShadow(config, &arena);
+}
+
+void BoxShadowRendererTest::testConcurrentRendering()
+{
+    QVector<ShadowConfig> configs;
+    for (int size = 0; size < 4; ++size) {
+        for (int strength : {64, 128, 255}) {
+            for (qreal dpr : {1.0, 1.5, 2.0}) {
+                configs.append({size, strength, dpr});
+            }
+        }
+    }
+
+    // Reference textures, rendered sequentially with temporary arenas.
+    QVector<QImage> references;
+    for (const ShadowConfig &config : qAsConst(configs)) {
+        references.append(renderShadow(config, nullptr));
+    }
+
+    // Render all combinations several times on the thread pool. Each thread reuses
+    // its arena across different sizes, so stale working memory would show up.
+    QVector<ShadowConfig> jobs;
+    for (int round = 0; round < 4; ++round) {
+        jobs += configs;
+    }
+
+    const QVector<QImage> results = QtConcurrent::blockingMapped<QVector<QImage>>(jobs, renderShadowWithThreadArena);
+
+    QCOMPARE(results.count(), jobs.count());
+    for (int i = 0; i < results.count(); ++i) {
+        QCOMPARE(results.at(i), references.at(i % configs.count()));
+    }
+}
+
+QTEST_GUILESS_MAIN(BoxShadowRendererTest)
+
+#include "boxshadowrenderertest.moc"
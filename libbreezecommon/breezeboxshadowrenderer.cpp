@@ -168,10 +168,11 @@ static inline void boxBlurRowAlpha(const uint8_t *src, uint8_t *dst, int width,
  *
  * @param image The input image.
  * @param radius The blur radius.
+ * @param arena Working memory for the blur buffers.
  * @param rect Specifies what part of the image to blur. If nothing is provided, then
  *    the whole alpha channel of the input image will be blurred.
  **/
-static inline void boxBlurAlpha(QImage &image, int radius, const QRect &rect = {})
+static inline void boxBlurAlpha(QImage &image, int radius, BoxShadowRenderer::ScratchArena &arena, const QRect &rect = {})
 {
     if (radius < 2) {
         return;
@@ -188,8 +189,7 @@ static inline void boxBlurAlpha(QImage &image, int radius, const QRect &rect = {
     const int pixelStride = image.depth() >> 3;
 
     const int bufferStride = qMax(width, height) * pixelStride;
-    QScopedPointer<uint8_t, QScopedPointerArrayDeleter<uint8_t> > buf(new uint8_t[2 * bufferStride]);
-    uint8_t *buf1 = buf.data();
+    uint8_t *buf1 = arena.bytes(2 * bufferStride);
     uint8_t *buf2 = buf1 + bufferStride;
 
     // Blur the image in horizontal direction.
@@ -209,6 +209,145 @@ static inline void boxBlurAlpha(QImage &image, int radius, const QRect &rect = {
     }
 }
 
+struct RecursiveGaussianCoefficients
+{
+    qreal b;  ///< input weight
+    qreal b1; ///< weight of the previous output
+    qreal b2; ///< weight of the output before the previous one
+    qreal b3; ///< weight of the output three steps back
+};
+
+/**
+ * Compute recursive gaussian filter coefficients.
+ *
+ * See I. T. Young, L. J. van Vliet, "Recursive implementation of the Gaussian filter",
+ * Signal Processing 44 (1995) 139-151.
+ *
+ * @param stdDev The standard deviation of the gaussian, at least 0.5.
+ **/
+static RecursiveGaussianCoefficients computeRecursiveGaussianCoefficients(qreal stdDev)
+{
+    const qreal q = stdDev >= 2.5
+        ? 0.98711 * stdDev - 0.96330
+        : 3.97156 - 4.14554 * qSqrt(1.0 - 0.26891 * stdDev);
+
+    const qreal q2 = q * q;
+    const qreal q3 = q2 * q;
+
+    const qreal b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    const qreal b1 = 2.44413 * q + 2.85619 * q2 + 1.26661 * q3;
+    const qreal b2 = -(1.4281 * q2 + 1.26661 * q3);
+    const qreal b3 = 0.422205 * q3;
+
+    return {
+        1.0 - (b1 + b2 + b3) / b0,
+        b1 / b0,
+        b2 / b0,
+        b3 / b0
+    };
+}
+
+/**
+ * Process a row with a recursive gaussian filter, in place.
+ *
+ * One causal pass runs forward into @p buffer, one anti-causal pass runs
+ * backward from @p buffer into the row. Values outside of the row are
+ * replaced by the closest value in the row, like the box filter does.
+ *
+ * @param data The start of the row.
+ * @param length The length of the row, in pixels.
+ * @param step The number of bytes from one alpha value to the next alpha value.
+ * @param coefficients Params of the recursive filter.
+ * @param buffer Scratch buffer, at least @p length values.
+ **/
+static inline void recursiveBlurRowAlpha(uint8_t *data, int length, int step,
+                                         const RecursiveGaussianCoefficients &coefficients, float *buffer)
+{
+    // The poles get close to 1 for large deviations, so the recursion is kept in double precision.
+    const qreal b = coefficients.b;
+    const qreal b1 = coefficients.b1;
+    const qreal b2 = coefficients.b2;
+    const qreal b3 = coefficients.b3;
+
+    // Causal pass.
+    qreal w1 = data[0];
+    qreal w2 = w1;
+    qreal w3 = w1;
+    const uint8_t *in = data;
+    for (int i = 0; i < length; ++i, in += step) {
+        const qreal w = b * *in + b1 * w1 + b2 * w2 + b3 * w3;
+        buffer[i] = w;
+        w3 = w2;
+        w2 = w1;
+        w1 = w;
+    }
+
+    // Anti-causal pass.
+    w1 = buffer[length - 1];
+    w2 = w1;
+    w3 = w1;
+    uint8_t *out = data + (length - 1) * step;
+    for (int i = length - 1; i >= 0; --i, out -= step) {
+        const qreal w = b * buffer[i] + b1 * w1 + b2 * w2 + b3 * w3;
+        *out = qBound(0, qRound(w), 255);
+        w3 = w2;
+        w2 = w1;
+        w1 = w;
+    }
+}
+
+/**
+ * Blur the alpha channel of a given image with a recursive gaussian filter.
+ *
+ * Unlike boxBlurAlpha, a single pass is made in each direction, and the cost
+ * per pixel does not depend on the blur radius. The filter gets too narrow past
+ * a standard deviation of about 64 pixels, so larger blurs are split into several
+ * passes of smaller deviation, whose variances add up.
+ *
+ * @param image The input image.
+ * @param radius The blur radius.
+ * @param arena Working memory for the blur buffers.
+ * @param rect Specifies what part of the image to blur. If nothing is provided, then
+ *    the whole alpha channel of the input image will be blurred.
+ **/
+static inline void recursiveBlurAlpha(QImage &image, int radius, BoxShadowRenderer::ScratchArena &arena, const QRect &rect = {})
+{
+    if (radius < 2) {
+        return;
+    }
+
+    const qreal maxPassStdDev = 64.0;
+    const qreal stdDev = calculateBlurStdDev(radius);
+    const int passes = qCeil((stdDev * stdDev) / (maxPassStdDev * maxPassStdDev));
+    const RecursiveGaussianCoefficients coefficients = computeRecursiveGaussianCoefficients(stdDev / qSqrt(passes));
+
+    const QRect blurRect = rect.isNull() ? image.rect() : rect;
+
+    const int alphaOffset = QSysInfo::ByteOrder == QSysInfo::BigEndian ? 0 : 3;
+    const int width = blurRect.width();
+    const int height = blurRect.height();
+    const int rowStride = image.bytesPerLine();
+    const int pixelStride = image.depth() >> 3;
+
+    float *buf = arena.floats(qMax(width, height));
+
+    // Blur the image in horizontal direction.
+    for (int i = 0; i < height; ++i) {
+        uint8_t *row = image.scanLine(blurRect.y() + i) + blurRect.x() * pixelStride + alphaOffset;
+        for (int pass = 0; pass < passes; ++pass) {
+            recursiveBlurRowAlpha(row, width, pixelStride, coefficients, buf);
+        }
+    }
+
+    // Blur the image in vertical direction.
+    for (int i = 0; i < width; ++i) {
+        uint8_t *column = image.scanLine(blurRect.y()) + (blurRect.x() + i) * pixelStride + alphaOffset;
+        for (int pass = 0; pass < passes; ++pass) {
+            recursiveBlurRowAlpha(column, height, rowStride, coefficients, buf);
+        }
+    }
+}
+
 static inline void mirrorTopLeftQuadrant(QImage &image)
 {
     const int width = image.width();
@@ -231,7 +370,7 @@ static inline void mirrorTopLeftQuadrant(QImage &image)
 
     for (int y = 0; y < centerY; ++y) {
         const uint8_t *in = image.scanLine(y) + alphaOffset;
-        uint8_t *out = image.scanLine(width - y - 1) + alphaOffset;
+        uint8_t *out = image.scanLine(height - y - 1) + alphaOffset;
 
         for (int x = 0; x < width; ++x, in += stride, out += stride) {
             *out = *in;
@@ -239,16 +378,42 @@ static inline void mirrorTopLeftQuadrant(QImage &image)
     }
 }
 
-static void renderShadow(QPainter *painter, const QRect &rect, qreal borderRadius, const QPoint &offset, int radius, const QColor &color)
+/**
+ * Compute the factor by which the shadow can be rendered at a lower resolution.
+ *
+ * The result of a large blur has very low frequencies, so it can be computed at
+ * a reduced resolution and upscaled with a bilinear filter. Factors are chosen so
+ * that the downsampled blur radius remains at least 24 pixels. The difference with
+ * the full resolution shadow then stays within the error of the box approximation
+ * itself, below 5 (out of 255).
+ *
+ * @param scaledRadius The blur radius, in device pixels.
+ **/
+static inline int calculateDownsamplingFactor(int scaledRadius)
+{
+    if (scaledRadius >= 128) {
+        return 4;
+    }
+
+    if (scaledRadius >= 48) {
+        return 2;
+    }
+
+    return 1;
+}
+
+static void renderShadow(QPainter *painter, const QRect &rect, qreal borderRadius, const QPoint &offset, int radius, const QColor &color,
+                         BoxShadowRenderer::BlurMethod blurMethod, bool downsampling, BoxShadowRenderer::ScratchArena &arena)
 {
     const QSize inflation = calculateBlurExtent(radius);
     const QSize size = rect.size() + 2 * inflation;
 
-    const qreal dpr = painter->device()->devicePixelRatioF();
+    // Large blurs are computed at a lower resolution, then upscaled.
+    const qreal targetDpr = painter->device()->devicePixelRatioF();
+    const int downsamplingFactor = downsampling ? calculateDownsamplingFactor(qRound(radius * targetDpr)) : 1;
+    const qreal dpr = targetDpr / downsamplingFactor;
 
-    QImage shadow(size * dpr, QImage::Format_ARGB32_Premultiplied);
-    shadow.setDevicePixelRatio(dpr);
-    shadow.fill(Qt::transparent);
+    QImage &shadow = arena.image(size * dpr, dpr);
 
     QRect boxRect(QPoint(0, 0), rect.size());
     boxRect.moveCenter(QRect(QPoint(0, 0), size).center());
@@ -268,7 +433,16 @@ static void renderShadow(QPainter *painter, const QRect &rect, qreal borderRadiu
     // only the top-left quadrant and then mirror it.
     const QRect blurRect(0, 0, qCeil(shadow.width() * 0.5), qCeil(shadow.height() * 0.5));
     const int scaledRadius = qRound(radius * dpr);
-    boxBlurAlpha(shadow, scaledRadius, blurRect);
+    switch (blurMethod) {
+    case BoxShadowRenderer::BlurMethod::RecursiveGaussian:
+        recursiveBlurAlpha(shadow, scaledRadius, arena, blurRect);
+        break;
+
+    case BoxShadowRenderer::BlurMethod::Box:
+    default:
+        boxBlurAlpha(shadow, scaledRadius, arena, blurRect);
+        break;
+    }
     mirrorTopLeftQuadrant(shadow);
 
     // Give the shadow a tint of the desired color.
@@ -278,12 +452,64 @@ static void renderShadow(QPainter *painter, const QRect &rect, qreal borderRadiu
     shadowPainter.end();
 
     // Actually, present the shadow.
+    if (downsamplingFactor > 1) {
+        QRect shadowRect(QPoint(0, 0), size);
+        shadowRect.moveCenter(rect.center() + offset);
+
+        painter->save();
+        painter->setRenderHint(QPainter::SmoothPixmapTransform);
+        painter->drawImage(shadowRect, shadow);
+        painter->restore();
+        return;
+    }
+
     QRect shadowRect = shadow.rect();
     shadowRect.setSize(shadowRect.size() / dpr);
     shadowRect.moveCenter(rect.center() + offset);
     painter->drawImage(shadowRect, shadow);
 }
 
+QImage &BoxShadowRenderer::ScratchArena::image(const QSize &size, qreal dpr)
+{
+    // Layers of a shadow usually have a few distinct sizes, keep the most recent ones.
+    int index = -1;
+    for (int i = 0; i < m_images.count(); ++i) {
+        if (m_images.at(i).size() == size) {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == -1) {
+        if (m_images.count() == 4) {
+            m_images.removeFirst();
+        }
+        m_images.append(QImage(size, QImage::Format_ARGB32_Premultiplied));
+        index = m_images.count() - 1;
+    }
+
+    QImage &image = m_images[index];
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+    return image;
+}
+
+quint8 *BoxShadowRenderer::ScratchArena::bytes(int size)
+{
+    if (m_bytes.size() < size) {
+        m_bytes.resize(size);
+    }
+    return m_bytes.data();
+}
+
+float *BoxShadowRenderer::ScratchArena::floats(int size)
+{
+    if (m_floats.size() < size) {
+        m_floats.resize(size);
+    }
+    return m_floats.data();
+}
+
 void BoxShadowRenderer::setBoxSize(const QSize &size)
 {
     m_boxSize = size;
@@ -299,6 +525,16 @@ void BoxShadowRenderer::setDevicePixelRatio(qreal dpr)
     m_dpr = dpr;
 }
 
+void BoxShadowRenderer::setBlurMethod(BlurMethod method)
+{
+    m_blurMethod = method;
+}
+
+void BoxShadowRenderer::setDownsamplingEnabled(bool enabled)
+{
+    m_downsampling = enabled;
+}
+
 void BoxShadowRenderer::addShadow(const QPoint &offset, int radius, const QColor &color)
 {
     Shadow shadow = {};
@@ -308,12 +544,17 @@ void BoxShadowRenderer::addShadow(const QPoint &offset, int radius, const QColor
     m_shadows.append(shadow);
 }
 
-QImage BoxShadowRenderer::render() const
+QImage BoxShadowRenderer::render(ScratchArena *arena) const
 {
     if (m_shadows.isEmpty()) {
         return {};
     }
 
+    ScratchArena temporaryArena;
+    if (!arena) {
+        arena = &temporaryArena;
+    }
+
     QSize canvasSize;
     for (const Shadow &shadow : qAsConst(m_shadows)) {
         canvasSize = canvasSize.expandedTo(
@@ -329,7 +570,7 @@ QImage BoxShadowRenderer::render() const
 
     QPainter painter(&canvas);
     for (const Shadow &shadow : qAsConst(m_shadows)) {
-        renderShadow(&painter, boxRect, m_borderRadius, shadow.offset, shadow.radius, shadow.color);
+        renderShadow(&painter, boxRect, m_borderRadius, shadow.offset, shadow.radius, shadow.color, m_blurMethod, m_downsampling, *arena);
     }
     painter.end();
 
@@ -14,13 +14,69 @@
 #include <QImage>
 #include <QPoint>
 #include <QSize>
+#include <QVector>
 
 namespace Breeze
 {
 
+/**
+ * Renders the shadow of a box with rounded corners.
+ *
+ * The renderer is reentrant: it has no shared state, and render() does not modify
+ * the renderer, so shadows can be rendered from several threads at once, including
+ * with the same renderer, as long as each thread uses its own scratch arena.
+ **/
 class BREEZECOMMON_EXPORT BoxShadowRenderer
 {
 public:
+    /**
+     * Working memory that can be reused across renders.
+     *
+     * An arena must not be used by several renders at the same time. Keep one
+     * arena per thread to render many shadows without reallocating layers and
+     * blur buffers each time.
+     **/
+    class BREEZECOMMON_EXPORT ScratchArena
+    {
+    public:
+        /**
+         * Get a transparent image.
+         *
+         * The image remains valid until the next call.
+         * @param size The size of the image, in device pixels.
+         * @param dpr The device pixel ratio of the image.
+         **/
+        QImage &image(const QSize &size, qreal dpr);
+
+        /**
+         * Get a byte buffer.
+         * @param size The minimum size of the buffer, in bytes.
+         **/
+        quint8 *bytes(int size);
+
+        /**
+         * Get a float buffer.
+         * @param size The minimum size of the buffer, in values.
+         **/
+        float *floats(int size);
+
+    private:
+        QVector<QImage> m_images;
+        QVector<quint8> m_bytes;
+        QVector<float> m_floats;
+    };
+
+    /**
+     * Blur algorithm.
+     **/
+    enum class BlurMethod {
+        /// Three successive box filters approximating a gaussian, in each direction.
+        Box,
+        /// Recursive gaussian filter, with a single pass in each direction up to
+        /// a blur radius of 128 device pixels. Its cost does not depend on the blur radius.
+        RecursiveGaussian,
+    };
+
     // Compiler generated constructors & destructor are fine.
 
     /**
@@ -41,6 +97,22 @@ public:
      **/
     void setDevicePixelRatio(qreal dpr);
 
+    /**
+     * Set the blur algorithm. Box filters are used by default.
+     * @param method The blur algorithm.
+     **/
+    void setBlurMethod(BlurMethod method);
+
+    /**
+     * Allow large blurs to be computed at a lower resolution.
+     *
+     * The downsampling factor is chosen from the blur radius in device pixels,
+     * so that the difference with the full resolution shadow stays invisible.
+     * Disabled by default.
+     * @param enabled Whether downsampling is allowed.
+     **/
+    void setDownsamplingEnabled(bool enabled);
+
     /**
      * Add a shadow.
      * @param offset The offset of the shadow.
@@ -51,8 +123,9 @@ public:
 
     /**
      * Render the shadow.
+     * @param arena Working memory to use. A temporary one is used if none is provided.
      **/
-    QImage render() const;
+    QImage render(ScratchArena *arena = nullptr) const;
 
     /**
      * Calculate the minimum size of the box.
@@ -80,6 +153,8 @@ private:
     QSize m_boxSize;
     qreal m_borderRadius = 0.0;
     qreal m_dpr = 1.0;
+    BlurMethod m_blurMethod = BlurMethod::Box;
+    bool m_downsampling = false;
 
     struct Shadow {
         QPoint offset;